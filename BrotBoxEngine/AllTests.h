@@ -9,6 +9,26 @@
 #include "OtherTest.h"
 #include "UtilTest.h"
 #include "UniquePointerTest.h"
+#include "HashMapTest.h"
+#include "ConcurrentHashMapTest.h"
+#include "SlotMapTest.h"
+#include "QueueTest.h"
+#include "SoAListTest.h"
+#include "ColonyTest.h"
+#include "RadixSortTest.h"
+#include "FrozenListTest.h"
+#include "BitSetTest.h"
+#include "HeapTest.h"
+#include "DynamicArrayTest.h"
+#include "FlatFileTest.h"
+#include "CopyOnWriteListTest.h"
+#include "Utf8StringTest.h"
+#include "StringSearchTest.h"
+#include "StringCaseTest.h"
+#include "StringBuilderTest.h"
+#include "SymbolTest.h"
+#include "NumberConversionTest.h"
+#include "HashTest.h"
 
 namespace bbe {
 	namespace test {
@@ -28,6 +48,46 @@ namespace bbe {
 			Person::checkIfAllPersonsWereDestroyed();
 			bbe::test::testUniquePointer();
 			Person::checkIfAllPersonsWereDestroyed();
+			bbe::test::testHashMap();
+			Person::checkIfAllPersonsWereDestroyed();
+			bbe::test::testConcurrentHashMap();
+			Person::checkIfAllPersonsWereDestroyed();
+			bbe::test::testSlotMap();
+			Person::checkIfAllPersonsWereDestroyed();
+			bbe::test::testQueue();
+			Person::checkIfAllPersonsWereDestroyed();
+			bbe::test::testSoAList();
+			Person::checkIfAllPersonsWereDestroyed();
+			bbe::test::testColony();
+			Person::checkIfAllPersonsWereDestroyed();
+			bbe::test::testRadixSort();
+			Person::checkIfAllPersonsWereDestroyed();
+			bbe::test::testFrozenList();
+			Person::checkIfAllPersonsWereDestroyed();
+			bbe::test::testBitSet();
+			Person::checkIfAllPersonsWereDestroyed();
+			bbe::test::testHeap();
+			Person::checkIfAllPersonsWereDestroyed();
+			bbe::test::testDynamicArray();
+			Person::checkIfAllPersonsWereDestroyed();
+			bbe::test::testFlatFile();
+			Person::checkIfAllPersonsWereDestroyed();
+			bbe::test::testCopyOnWriteList();
+			Person::checkIfAllPersonsWereDestroyed();
+			bbe::test::testUtf8String();
+			Person::checkIfAllPersonsWereDestroyed();
+			bbe::test::testStringSearch();
+			Person::checkIfAllPersonsWereDestroyed();
+			bbe::test::testStringCase();
+			Person::checkIfAllPersonsWereDestroyed();
+			bbe::test::testStringBuilder();
+			Person::checkIfAllPersonsWereDestroyed();
+			bbe::test::testSymbol();
+			Person::checkIfAllPersonsWereDestroyed();
+			bbe::test::testNumberConversion();
+			Person::checkIfAllPersonsWereDestroyed();
+			bbe::test::testHash();
+			Person::checkIfAllPersonsWereDestroyed();
 		}
 	}
 }
\ No newline at end of file
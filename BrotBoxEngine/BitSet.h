@@ -0,0 +1,396 @@
+#pragma once
+
+#include <cstdint>
+#include "List.h"
+#include "UtilDebug.h"
+#include "UtilMath.h"
+
+#ifdef __AVX2__
+#define BBE_BITSET_USE_AVX2
+#include <immintrin.h>
+#endif
+
+namespace bbe
+{
+	namespace INTERNAL
+	{
+		class BitSetAnd
+		{
+		public:
+			uint64_t operator()(uint64_t a, uint64_t b) const
+			{
+				return a & b;
+			}
+		};
+
+		class BitSetOr
+		{
+		public:
+			uint64_t operator()(uint64_t a, uint64_t b) const
+			{
+				return a | b;
+			}
+		};
+
+		class BitSetXor
+		{
+		public:
+			uint64_t operator()(uint64_t a, uint64_t b) const
+			{
+				return a ^ b;
+			}
+		};
+
+		class BitSetAndNot
+		{
+		public:
+			uint64_t operator()(uint64_t a, uint64_t b) const
+			{
+				return a & ~b;
+			}
+		};
+	}
+
+	class BitSet
+	{
+		//Bits are stored in 64 bit words. Bits past getLength() in the last word are always 0, so
+		//count and the find functions can work on whole words.
+	private:
+		static constexpr size_t BITS_PER_WORD = 64;
+
+		List<uint64_t> m_words;
+		size_t m_length = 0;
+
+		static size_t getAmountOfWords(size_t length)
+		{
+			return (length + BITS_PER_WORD - 1) / BITS_PER_WORD;
+		}
+
+		static uint64_t getMaskFrom(size_t bit)
+		{
+			//All bits at and above bit (0 to 63).
+			return ~(uint64_t)0 << bit;
+		}
+
+		void clearUnusedBits()
+		{
+			const size_t usedBitsOfLastWord = m_length % BITS_PER_WORD;
+			if (usedBitsOfLastWord != 0)
+			{
+				m_words.last() &= ~getMaskFrom(usedBitsOfLastWord);
+			}
+		}
+
+		template <typename Op>
+		void applyRange(const BitSet& other, size_t firstBit, size_t amountOfBits, Op op)
+		{
+			if (firstBit + amountOfBits > m_length || firstBit + amountOfBits > other.m_length)
+			{
+				debugBreak();
+				return;
+			}
+			if (amountOfBits == 0)
+			{
+				return;
+			}
+
+			const size_t lastBit = firstBit + amountOfBits - 1;
+			const size_t firstWord = firstBit / BITS_PER_WORD;
+			const size_t lastWord = lastBit / BITS_PER_WORD;
+			uint64_t* words = m_words.getRaw();
+			const uint64_t* otherWords = other.m_words.getRaw();
+
+			const uint64_t firstMask = getMaskFrom(firstBit % BITS_PER_WORD);
+			const uint64_t lastMask = ~getMaskFrom(lastBit % BITS_PER_WORD) | ((uint64_t)1 << (lastBit % BITS_PER_WORD));
+			if (firstWord == lastWord)
+			{
+				const uint64_t mask = firstMask & lastMask;
+				words[firstWord] = (words[firstWord] & ~mask) | (op(words[firstWord], otherWords[firstWord]) & mask);
+				return;
+			}
+
+			words[firstWord] = (words[firstWord] & ~firstMask) | (op(words[firstWord], otherWords[firstWord]) & firstMask);
+			for (size_t i = firstWord + 1; i < lastWord; i++)
+			{
+				words[i] = op(words[i], otherWords[i]);
+			}
+			words[lastWord] = (words[lastWord] & ~lastMask) | (op(words[lastWord], otherWords[lastWord]) & lastMask);
+		}
+
+	public:
+		BitSet()
+		{
+			//do nothing
+		}
+
+		explicit BitSet(size_t length, bool value = false)
+		{
+			resize(length, value);
+		}
+
+		void resize(size_t newLength, bool value = false)
+		{
+			//New bits are set to value.
+			const size_t oldLength = m_length;
+			const size_t newAmountOfWords = getAmountOfWords(newLength);
+			if (newAmountOfWords < m_words.getLength())
+			{
+				m_words.popBack(m_words.getLength() - newAmountOfWords);
+			}
+			else if (newAmountOfWords > m_words.getLength())
+			{
+				m_words.pushBack(value ? ~(uint64_t)0 : 0, newAmountOfWords - m_words.getLength());
+			}
+			m_length = newLength;
+
+			if (value && newLength > oldLength && oldLength % BITS_PER_WORD != 0)
+			{
+				m_words[oldLength / BITS_PER_WORD] |= getMaskFrom(oldLength % BITS_PER_WORD);
+			}
+			clearUnusedBits();
+		}
+
+		size_t getLength() const
+		{
+			return m_length;
+		}
+
+		bool isEmpty() const
+		{
+			return m_length == 0;
+		}
+
+		bool get(size_t index) const
+		{
+			if (index >= m_length)
+			{
+				debugBreak();
+			}
+			return (m_words[index / BITS_PER_WORD] >> (index % BITS_PER_WORD)) & 1;
+		}
+
+		bool operator[](size_t index) const
+		{
+			return get(index);
+		}
+
+		void set(size_t index)
+		{
+			if (index >= m_length)
+			{
+				debugBreak();
+			}
+			m_words[index / BITS_PER_WORD] |= (uint64_t)1 << (index % BITS_PER_WORD);
+		}
+
+		void set(size_t index, bool value)
+		{
+			if (value)
+			{
+				set(index);
+			}
+			else
+			{
+				reset(index);
+			}
+		}
+
+		void reset(size_t index)
+		{
+			if (index >= m_length)
+			{
+				debugBreak();
+			}
+			m_words[index / BITS_PER_WORD] &= ~((uint64_t)1 << (index % BITS_PER_WORD));
+		}
+
+		void flip(size_t index)
+		{
+			if (index >= m_length)
+			{
+				debugBreak();
+			}
+			m_words[index / BITS_PER_WORD] ^= (uint64_t)1 << (index % BITS_PER_WORD);
+		}
+
+		void setAll()
+		{
+			for (size_t i = 0; i < m_words.getLength(); i++)
+			{
+				m_words[i] = ~(uint64_t)0;
+			}
+			clearUnusedBits();
+		}
+
+		void resetAll()
+		{
+			for (size_t i = 0; i < m_words.getLength(); i++)
+			{
+				m_words[i] = 0;
+			}
+		}
+
+		size_t count() const
+		{
+			//Amount of set bits.
+			const uint64_t* words = m_words.getRaw();
+			const size_t amountOfWords = m_words.getLength();
+			size_t i = 0;
+			size_t retVal = 0;
+#ifdef BBE_BITSET_USE_AVX2
+			//Nibble lookup with pshufb, summed up per 64 bit lane by psadbw.
+			const __m256i lookup = _mm256_setr_epi8(
+				0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+				0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+			const __m256i lowMask = _mm256_set1_epi8(0x0F);
+			__m256i sum = _mm256_setzero_si256();
+			for (; i + 4 <= amountOfWords; i += 4)
+			{
+				const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+				const __m256i low = _mm256_and_si256(v, lowMask);
+				const __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), lowMask);
+				const __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low), _mm256_shuffle_epi8(lookup, high));
+				sum = _mm256_add_epi64(sum, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+			}
+			uint64_t lanes[4];
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), sum);
+			retVal += (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+#endif
+			for (; i < amountOfWords; i++)
+			{
+				retVal += popCount(words[i]);
+			}
+			return retVal;
+		}
+
+		bool isAnySet() const
+		{
+			for (size_t i = 0; i < m_words.getLength(); i++)
+			{
+				if (m_words[i] != 0)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		size_t findNextSet(size_t index) const
+		{
+			//Returns the first set bit at or after index, or getLength() if there is none.
+			if (index >= m_length)
+			{
+				return m_length;
+			}
+			size_t wordIndex = index / BITS_PER_WORD;
+			uint64_t word = m_words[wordIndex] & getMaskFrom(index % BITS_PER_WORD);
+			while (word == 0)
+			{
+				wordIndex++;
+				if (wordIndex == m_words.getLength())
+				{
+					return m_length;
+				}
+				word = m_words[wordIndex];
+			}
+			return wordIndex * BITS_PER_WORD + countTrailingZeros(word);
+		}
+
+		size_t findFirstSet() const
+		{
+			return findNextSet(0);
+		}
+
+		template <typename Func>
+		void forEachSetBit(Func func) const
+		{
+			//Calls func(size_t index) for every set bit in ascending order.
+			for (size_t i = 0; i < m_words.getLength(); i++)
+			{
+				uint64_t word = m_words[i];
+				while (word != 0)
+				{
+					func(i * BITS_PER_WORD + countTrailingZeros(word));
+					word &= word - 1;
+				}
+			}
+		}
+
+		void andRange(const BitSet& other, size_t firstBit, size_t amountOfBits)
+		{
+			applyRange(other, firstBit, amountOfBits, INTERNAL::BitSetAnd());
+		}
+
+		void orRange(const BitSet& other, size_t firstBit, size_t amountOfBits)
+		{
+			applyRange(other, firstBit, amountOfBits, INTERNAL::BitSetOr());
+		}
+
+		void xorRange(const BitSet& other, size_t firstBit, size_t amountOfBits)
+		{
+			applyRange(other, firstBit, amountOfBits, INTERNAL::BitSetXor());
+		}
+
+		void andNotRange(const BitSet& other, size_t firstBit, size_t amountOfBits)
+		{
+			//Resets all bits in the range that are set in other.
+			applyRange(other, firstBit, amountOfBits, INTERNAL::BitSetAndNot());
+		}
+
+		BitSet& operator&=(const BitSet& other)
+		{
+			andRange(other, 0, m_length);
+			return *this;
+		}
+
+		BitSet& operator|=(const BitSet& other)
+		{
+			orRange(other, 0, m_length);
+			return *this;
+		}
+
+		BitSet& operator^=(const BitSet& other)
+		{
+			xorRange(other, 0, m_length);
+			return *this;
+		}
+
+		BitSet& andNot(const BitSet& other)
+		{
+			andNotRange(other, 0, m_length);
+			return *this;
+		}
+
+		bool operator==(const BitSet& other) const
+		{
+			if (m_length != other.m_length)
+			{
+				return false;
+			}
+			for (size_t i = 0; i < m_words.getLength(); i++)
+			{
+				if (m_words[i] != other.m_words[i])
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		bool operator!=(const BitSet& other) const
+		{
+			return !operator==(other);
+		}
+
+		uint64_t* getRaw()
+		{
+			//The words, bit i is bit (i % 64) of word i / 64.
+			return m_words.getRaw();
+		}
+
+		const uint64_t* getRaw() const
+		{
+			return m_words.getRaw();
+		}
+	};
+}
\ No newline at end of file
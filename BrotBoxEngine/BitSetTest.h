@@ -0,0 +1,140 @@
+#pragma once
+
+#include "BitSet.h"
+#include "List.h"
+#include "UtilTest.h"
+
+namespace bbe
+{
+	namespace test
+	{
+		void testBitSet()
+		{
+			{
+				BitSet bitSet;
+				assertEquals(bitSet.getLength(), 0);
+				assertEquals(bitSet.isEmpty(), true);
+				assertEquals(bitSet.count(), 0);
+				assertEquals(bitSet.findFirstSet(), 0);
+				assertEquals(bitSet.isAnySet(), false);
+			}
+
+			{
+				BitSet bitSet(200);
+				assertEquals(bitSet.getLength(), 200);
+				assertEquals(bitSet.count(), 0);
+				assertEquals(bitSet.findFirstSet(), 200);
+
+				bitSet.set(0);
+				bitSet.set(63);
+				bitSet.set(64);
+				bitSet.set(199);
+				bitSet.set(100, true);
+				bitSet.set(101, false);
+				assertEquals(bitSet.get(0), true);
+				assertEquals(bitSet[63], true);
+				assertEquals(bitSet[1], false);
+				assertEquals(bitSet[101], false);
+				assertEquals(bitSet.count(), 5);
+				assertEquals(bitSet.isAnySet(), true);
+
+				assertEquals(bitSet.findFirstSet(), 0);
+				assertEquals(bitSet.findNextSet(1), 63);
+				assertEquals(bitSet.findNextSet(64), 64);
+				assertEquals(bitSet.findNextSet(65), 100);
+				assertEquals(bitSet.findNextSet(101), 199);
+				assertEquals(bitSet.findNextSet(200), 200);
+
+				List<size_t> setBits;
+				bitSet.forEachSetBit(
+					[&](size_t index)
+					{
+						setBits.pushBack(index);
+					});
+				assertEquals(setBits.getLength(), 5);
+				assertEquals(setBits[0], 0);
+				assertEquals(setBits[1], 63);
+				assertEquals(setBits[2], 64);
+				assertEquals(setBits[3], 100);
+				assertEquals(setBits[4], 199);
+
+				bitSet.flip(0);
+				bitSet.flip(1);
+				bitSet.reset(199);
+				assertEquals(bitSet[0], false);
+				assertEquals(bitSet[1], true);
+				assertEquals(bitSet.count(), 4);
+
+				bitSet.setAll();
+				assertEquals(bitSet.count(), 200);
+				bitSet.resetAll();
+				assertEquals(bitSet.count(), 0);
+			}
+
+			{
+				BitSet bitSet(10, true);
+				assertEquals(bitSet.count(), 10);
+				bitSet.resize(100, true);
+				assertEquals(bitSet.count(), 100);
+				bitSet.resize(130, false);
+				assertEquals(bitSet.count(), 100);
+				assertEquals(bitSet[129], false);
+				bitSet.resize(70);
+				assertEquals(bitSet.count(), 70);
+				bitSet.resize(140);
+				assertEquals(bitSet.count(), 70);
+			}
+
+			{
+				BitSet a(1000);
+				BitSet b(1000);
+				for (size_t i = 0; i < 1000; i += 2)
+				{
+					a.set(i);
+				}
+				for (size_t i = 0; i < 1000; i += 3)
+				{
+					b.set(i);
+				}
+				assertEquals(a.count(), 500);
+				assertEquals(b.count(), 334);
+
+				BitSet c = a;
+				c &= b;
+				assertEquals(c.count(), 167);
+				c = a;
+				c |= b;
+				assertEquals(c.count(), 667);
+				c = a;
+				c ^= b;
+				assertEquals(c.count(), 500);
+				c = a;
+				c.andNot(b);
+				assertEquals(c.count(), 333);
+				assertEquals(c == a, false);
+				assertEquals(c != a, true);
+
+				//Only the bits 100 to 299 change.
+				c = a;
+				c.andNotRange(a, 100, 200);
+				assertEquals(c.count(), 400);
+				assertEquals(c[98], true);
+				assertEquals(c[100], false);
+				assertEquals(c[298], false);
+				assertEquals(c[300], true);
+
+				c = a;
+				c.orRange(b, 3, 5);
+				assertEquals(c[3], true);
+				assertEquals(c[9], false);
+				assertEquals(c.count(), 501);
+
+				c = a;
+				c.xorRange(a, 64, 64);
+				assertEquals(c.count(), 468);
+				c.andRange(b, 0, 1000);
+				assertEquals(c.count(), 167 - 11);
+			}
+		}
+	}
+}
\ No newline at end of file
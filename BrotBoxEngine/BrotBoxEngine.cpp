@@ -6,6 +6,11 @@
 #include "AllTests.h"
 #include "PoolAllocatorPerformanceTime.h"
 #include "StringPerformanceTime.h"
+#include "HashMapPerformanceTime.h"
+#include "ConcurrentHashMapPerformanceTime.h"
+#include "QueuePerformanceTime.h"
+#include "SortPerformanceTime.h"
+#include "HeapPerformanceTime.h"
 #include "List.h"
 #include "UniquePointer.h"
 #include "Window.h"
@@ -57,6 +62,13 @@ int main()
 	bbe::test::runAllTests();
 	//bbe::test::poolAllocatorPrintAllocationSpeed();
 	//bbe::test::stringSpeed();
+	//bbe::test::stringSearchSpeed();
+	//bbe::test::stringCaseSpeed();
+	//bbe::test::hashMapPrintSpeed();
+	//bbe::test::concurrentHashMapPrintThroughput();
+	//bbe::test::queuePrintLatencyAndThroughput();
+	//bbe::test::sortPrintScaling();
+	//bbe::test::heapPrintSpeed();
 
     return 0;
 }
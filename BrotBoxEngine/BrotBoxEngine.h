@@ -3,8 +3,29 @@
 #include "Array.h";
 #include "DynamicArray.h"
 #include "List.h"
+#include "HashMap.h"
+#include "ConcurrentHashMap.h"
+#include "GenerationalHandle.h"
+#include "SlotMap.h"
+#include "SPSCQueue.h"
+#include "MPMCQueue.h"
+#include "SoAList.h"
+#include "Colony.h"
+#include "RadixSort.h"
+#include "FrozenList.h"
+#include "BitSet.h"
+#include "Heap.h"
+#include "CopyOnWriteList.h"
 
+#include "NumberConversion.h"
 #include "String.h"
+#include "StringSearch.h"
+#include "StringCase.h"
+#include "StringBuilder.h"
+#include "Symbol.h"
+#include "StringView.h"
+#include "Utf8String.h"
+#include "FlatFile.h"
 
 #include "DefaultDestroyer.h"
 #include "GeneralPurposeAllocator.h"
@@ -17,6 +38,8 @@
 #include "StopWatch.h"
 
 #include "DataType.h"
+#include "Hash.h"
 #include "STLCapsule.h"
 #include "UtilDebug.h"
+#include "UtilHash.h"
 #include "UtilMath.h"
\ No newline at end of file
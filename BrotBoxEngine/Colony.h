@@ -0,0 +1,325 @@
+#pragma once
+
+#include <cstdint>
+#include "List.h"
+#include "STLAllocator.h"
+#include "STLCapsule.h"
+#include "UtilDebug.h"
+#include "UtilMath.h"
+
+namespace bbe
+{
+	namespace INTERNAL
+	{
+		template <typename T>
+		union ColonyChunk
+		{
+			//same trick as the ListChunk, T is only constructed on insert
+			T value;
+
+			ColonyChunk() {}
+			~ColonyChunk() {}
+		};
+
+		template <typename T>
+		class ColonyBlock
+		{
+		public:
+			static constexpr size_t COLONY_BLOCK_SIZE = 64;
+			static constexpr uint64_t COLONY_BLOCK_FULL = ~(uint64_t)0;
+
+			//The skip field. Bit i is set if m_chunks[i] holds a value.
+			uint64_t m_occupied = 0;
+			bool m_isInFreeBlocks = false;
+			ColonyChunk<T> m_chunks[COLONY_BLOCK_SIZE];
+
+			bool contains(const T* value) const
+			{
+				const ColonyChunk<T>* chunk = reinterpret_cast<const ColonyChunk<T>*>(value);
+				return chunk >= m_chunks && chunk < m_chunks + COLONY_BLOCK_SIZE;
+			}
+		};
+	}
+
+	template <typename T, typename Allocator = STLAllocator<INTERNAL::ColonyBlock<T>>>
+	class Colony
+	{
+		//Unordered container that never moves its values. It grows by appending blocks of 64 slots
+		//and reuses erased slots before it allocates a new block, so pointers to the values stay
+		//valid until the value is removed. Like a PoolAllocator, but without a fixed capacity.
+	private:
+		typedef INTERNAL::ColonyBlock<T> Block;
+
+		//Sorted by address, so remove can find the block of a pointer with a binary search.
+		List<Block*> m_blocks;
+		//Blocks that have at least one free slot.
+		List<Block*> m_freeBlocks;
+		size_t m_length = 0;
+
+		Allocator* m_parentAllocator = nullptr;
+		bool m_needsToDeleteParentAllocator = false;
+
+		Block* allocateBlock()
+		{
+			Block* block = m_parentAllocator->allocate(1);
+			new (block) Block();
+
+			size_t index = m_blocks.getLength();
+			m_blocks.pushBack(block);
+			while (index > 0 && reinterpret_cast<uintptr_t>(m_blocks[index - 1]) > reinterpret_cast<uintptr_t>(block))
+			{
+				m_blocks[index] = m_blocks[index - 1];
+				index--;
+			}
+			m_blocks[index] = block;
+
+			block->m_isInFreeBlocks = true;
+			m_freeBlocks.pushBack(block);
+			return block;
+		}
+
+		void deallocateBlock(Block* block)
+		{
+			uint64_t occupied = block->m_occupied;
+			while (occupied != 0)
+			{
+				bbe::addressOf(block->m_chunks[countTrailingZeros(occupied)].value)->~T();
+				occupied &= occupied - 1;
+			}
+			block->~Block();
+			m_parentAllocator->deallocate(block, 1);
+		}
+
+		Block* findBlock(const T* value) const
+		{
+			size_t low = 0;
+			size_t high = m_blocks.getLength();
+			while (low < high)
+			{
+				const size_t mid = low + (high - low) / 2;
+				if (reinterpret_cast<uintptr_t>(m_blocks[mid]) <= reinterpret_cast<uintptr_t>(value))
+				{
+					low = mid + 1;
+				}
+				else
+				{
+					high = mid;
+				}
+			}
+			if (low == 0 || !m_blocks[low - 1]->contains(value))
+			{
+				return nullptr;
+			}
+			return m_blocks[low - 1];
+		}
+
+		void freeAllBlocks()
+		{
+			for (size_t i = 0; i < m_blocks.getLength(); i++)
+			{
+				deallocateBlock(m_blocks[i]);
+			}
+			m_blocks.clear();
+			m_freeBlocks.clear();
+			m_length = 0;
+		}
+
+	public:
+		explicit Colony(Allocator* parentAllocator = nullptr)
+			: m_parentAllocator(parentAllocator)
+		{
+			if (m_parentAllocator == nullptr)
+			{
+				m_parentAllocator = new Allocator();
+				m_needsToDeleteParentAllocator = true;
+			}
+		}
+
+		Colony(const Colony& other) = delete; //Copy Constructor
+		Colony(Colony&& other)
+			: m_blocks(std::move(other.m_blocks)), m_freeBlocks(std::move(other.m_freeBlocks)), m_length(other.m_length),
+			m_parentAllocator(other.m_parentAllocator), m_needsToDeleteParentAllocator(other.m_needsToDeleteParentAllocator)
+		{
+			other.m_length = 0;
+			other.m_parentAllocator = nullptr;
+			other.m_needsToDeleteParentAllocator = false;
+		}
+		Colony& operator=(const Colony& other) = delete; //Copy Assignment
+		Colony& operator=(Colony&& other)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+			freeAllBlocks();
+			if (m_needsToDeleteParentAllocator)
+			{
+				delete m_parentAllocator;
+			}
+			m_blocks = std::move(other.m_blocks);
+			m_freeBlocks = std::move(other.m_freeBlocks);
+			m_length = other.m_length;
+			m_parentAllocator = other.m_parentAllocator;
+			m_needsToDeleteParentAllocator = other.m_needsToDeleteParentAllocator;
+			other.m_length = 0;
+			other.m_parentAllocator = nullptr;
+			other.m_needsToDeleteParentAllocator = false;
+			return *this;
+		}
+
+		~Colony()
+		{
+			freeAllBlocks();
+			if (m_needsToDeleteParentAllocator)
+			{
+				delete m_parentAllocator;
+			}
+			m_parentAllocator = nullptr;
+		}
+
+		template <typename... arguments>
+		T* insert(arguments&&... args)
+		{
+			Block* block = m_freeBlocks.isEmpty() ? allocateBlock() : m_freeBlocks.last();
+			const size_t index = countTrailingZeros(~block->m_occupied);
+			T* value = bbe::addressOf(block->m_chunks[index].value);
+			new (value) T(std::forward<arguments>(args)...);
+
+			block->m_occupied |= (uint64_t)1 << index;
+			if (block->m_occupied == Block::COLONY_BLOCK_FULL)
+			{
+				block->m_isInFreeBlocks = false;
+				m_freeBlocks.popBack();
+			}
+			m_length++;
+			return value;
+		}
+
+		bool remove(T* value)
+		{
+			Block* block = findBlock(value);
+			if (block == nullptr)
+			{
+				return false;
+			}
+			const size_t index = reinterpret_cast<INTERNAL::ColonyChunk<T>*>(value) - block->m_chunks;
+			const uint64_t bit = (uint64_t)1 << index;
+			if ((block->m_occupied & bit) == 0)
+			{
+				return false;
+			}
+
+			value->~T();
+			block->m_occupied &= ~bit;
+			if (!block->m_isInFreeBlocks)
+			{
+				block->m_isInFreeBlocks = true;
+				m_freeBlocks.pushBack(block);
+			}
+			m_length--;
+			return true;
+		}
+
+		bool contains(const T* value) const
+		{
+			const Block* block = findBlock(value);
+			if (block == nullptr)
+			{
+				return false;
+			}
+			const size_t index = reinterpret_cast<const INTERNAL::ColonyChunk<T>*>(value) - block->m_chunks;
+			return (block->m_occupied & ((uint64_t)1 << index)) != 0;
+		}
+
+		void clear()
+		{
+			//Keeps the blocks, so that refilling the Colony does not allocate.
+			m_freeBlocks.clear();
+			for (size_t i = 0; i < m_blocks.getLength(); i++)
+			{
+				Block* block = m_blocks[i];
+				uint64_t occupied = block->m_occupied;
+				while (occupied != 0)
+				{
+					bbe::addressOf(block->m_chunks[countTrailingZeros(occupied)].value)->~T();
+					occupied &= occupied - 1;
+				}
+				block->m_occupied = 0;
+				block->m_isInFreeBlocks = true;
+				m_freeBlocks.pushBack(block);
+			}
+			m_length = 0;
+		}
+
+		bool shrink()
+		{
+			//Frees all empty blocks. Returns true if at least one block was freed.
+			List<Block*> blocks;
+			List<Block*> freeBlocks;
+			for (size_t i = 0; i < m_blocks.getLength(); i++)
+			{
+				Block* block = m_blocks[i];
+				if (block->m_occupied == 0)
+				{
+					deallocateBlock(block);
+					continue;
+				}
+				blocks.pushBack(block);
+				if (block->m_isInFreeBlocks)
+				{
+					freeBlocks.pushBack(block);
+				}
+			}
+			const bool retVal = blocks.getLength() != m_blocks.getLength();
+			m_blocks = std::move(blocks);
+			m_freeBlocks = std::move(freeBlocks);
+			return retVal;
+		}
+
+		template <typename Func>
+		void forEach(Func func)
+		{
+			//Calls func(T&) for every value in address order. func may remove the value it was called with.
+			for (size_t i = 0; i < m_blocks.getLength(); i++)
+			{
+				Block* block = m_blocks[i];
+				uint64_t occupied = block->m_occupied;
+				while (occupied != 0)
+				{
+					func(block->m_chunks[countTrailingZeros(occupied)].value);
+					occupied &= occupied - 1;
+				}
+			}
+		}
+
+		template <typename Func>
+		void forEach(Func func) const
+		{
+			for (size_t i = 0; i < m_blocks.getLength(); i++)
+			{
+				const Block* block = m_blocks[i];
+				uint64_t occupied = block->m_occupied;
+				while (occupied != 0)
+				{
+					func(block->m_chunks[countTrailingZeros(occupied)].value);
+					occupied &= occupied - 1;
+				}
+			}
+		}
+
+		size_t getLength() const
+		{
+			return m_length;
+		}
+
+		size_t getCapacity() const
+		{
+			return m_blocks.getLength() * Block::COLONY_BLOCK_SIZE;
+		}
+
+		bool isEmpty() const
+		{
+			return m_length == 0;
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "Colony.h"
+#include "List.h"
+#include "UtilTest.h"
+
+namespace bbe
+{
+	namespace test
+	{
+		void testColony()
+		{
+			{
+				Colony<Person> colony;
+				assertEquals(colony.getLength(), 0);
+				assertEquals(colony.isEmpty(), true);
+				assertEquals(colony.getCapacity(), 0);
+
+				List<Person*> persons;
+				for (int i = 0; i < 200; i++)
+				{
+					persons.pushBack(colony.insert("Name", "Addr", i));
+				}
+				assertEquals(colony.getLength(), 200);
+				assertEquals(colony.isEmpty(), false);
+				assertEquals(colony.getCapacity(), 256);
+
+				//Growing never moves values.
+				for (int i = 0; i < 200; i++)
+				{
+					assertEquals(persons[i]->age, i);
+					assertEquals(colony.contains(persons[i]), true);
+				}
+
+				for (int i = 0; i < 200; i += 2)
+				{
+					assertEquals(colony.remove(persons[i]), true);
+				}
+				assertEquals(colony.remove(persons[0]), false);
+				assertEquals(colony.contains(persons[0]), false);
+				assertEquals(colony.getLength(), 100);
+
+				int ageSum = 0;
+				int amount = 0;
+				colony.forEach(
+					[&](Person& p)
+					{
+						ageSum += p.age;
+						amount++;
+					});
+				assertEquals(amount, 100);
+				assertEquals(ageSum, 100 * 100);
+
+				//Erased slots are reused before new blocks are allocated.
+				for (int i = 0; i < 100; i++)
+				{
+					colony.insert("Name", "Addr", 1000);
+				}
+				assertEquals(colony.getLength(), 200);
+				assertEquals(colony.getCapacity(), 256);
+				for (int i = 1; i < 200; i += 2)
+				{
+					assertEquals(persons[i]->age, i);
+				}
+
+				Person outside;
+				assertEquals(colony.contains(&outside), false);
+				assertEquals(colony.remove(&outside), false);
+
+				colony.forEach(
+					[&](Person& p)
+					{
+						if (p.age == 1000)
+						{
+							colony.remove(&p);
+						}
+					});
+				assertEquals(colony.getLength(), 100);
+
+				Colony<Person> moved(std::move(colony));
+				assertEquals(colony.getLength(), 0);
+				assertEquals(moved.getLength(), 100);
+				assertEquals(moved.contains(persons[1]), true);
+
+				moved.clear();
+				assertEquals(moved.getLength(), 0);
+				assertEquals(moved.getCapacity(), 256);
+				assertEquals(moved.shrink(), true);
+				assertEquals(moved.getCapacity(), 0);
+
+				moved.insert("Name", "Addr", 5);
+				assertEquals(moved.getLength(), 1);
+			}
+
+			{
+				Colony<int> colony;
+				List<int*> values;
+				for (int i = 0; i < 1000; i++)
+				{
+					values.pushBack(colony.insert(i));
+				}
+				for (int i = 0; i < 1000; i++)
+				{
+					if (i % 64 != 0)
+					{
+						colony.remove(values[i]);
+					}
+				}
+				assertEquals(colony.getLength(), 16);
+				assertEquals(colony.shrink(), false);
+				int sum = 0;
+				colony.forEach(
+					[&](int& v)
+					{
+						sum += v;
+					});
+				assertEquals(sum, 64 * (15 * 16 / 2));
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,330 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <cstring>
+#include <type_traits>
+#include "HashMap.h"
+#include "List.h"
+
+namespace bbe
+{
+	template <typename K, typename V, typename Hasher = Hash<K>, size_t AMOUNT_OF_SHARDS = 64>
+	class ConcurrentHashMap
+	{
+		//Every shard is an independently locked HashMap. Writers lock their shard and make its
+		//version counter odd while they mutate it. If K and V are trivially copyable, readers
+		//do not lock at all: they read optimistically and retry if the version changed meanwhile.
+		//A shard never frees or reallocates a map that readers may still look at. Instead, a full
+		//map is replaced by a copy with twice as much room as it has entries. If the map is full of
+		//tombstones from removed keys, the copy can be just as big as the old map. The replaced map
+		//is retired. Optimistic readers register in m_activeReaders while they look at a map, and
+		//retired maps are freed by the next writer that sees no active reader. Without optimistic
+		//reads, readers hold the lock and the replaced map is freed right away. A shard that is read
+		//without a pause keeps its retired maps until the reads stop, reclaimRetiredMaps frees them
+		//as well.
+		//The optimistic reads are a deliberate seqlock race: the control bytes, keys and values are read
+		//with plain loads while a writer may store them, which the C++ memory model and thread sanitizers
+		//treat as a data race. Whatever a torn read produced is thrown away when the version changed, so
+		//this is only done for trivially copyable K and V. Their operator== may see a torn key and must
+		//not do more than compare its bytes.
+		static_assert(AMOUNT_OF_SHARDS > 0 && AMOUNT_OF_SHARDS <= 256 && (AMOUNT_OF_SHARDS & (AMOUNT_OF_SHARDS - 1)) == 0, "AMOUNT_OF_SHARDS must be a power of two not greater than 256!");
+	private:
+		typedef HashMap<K, V, Hasher> Map;
+		typedef std::integral_constant<bool, std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value> AllowsOptimisticReads;
+
+		static constexpr size_t CONCURRENT_HASH_MAP_OPTIMISTIC_RETRIES = 8;
+
+		class alignas(64) Shard
+		{
+		public:
+			mutable std::mutex m_mutex;
+			std::atomic<uint32_t> m_version;
+			mutable std::atomic<uint32_t> m_activeReaders;
+			std::atomic<Map*> m_map;
+			List<Map*> m_retiredMaps;
+
+			Shard()
+				: m_version(0), m_activeReaders(0), m_map(new Map())
+			{
+				//do nothing
+			}
+
+			~Shard()
+			{
+				delete m_map.load();
+				reclaimRetiredMaps();
+			}
+
+			void reclaimRetiredMaps()
+			{
+				for (size_t i = 0; i < m_retiredMaps.getLength(); i++)
+				{
+					delete m_retiredMaps[i];
+				}
+				m_retiredMaps.clear();
+			}
+
+			void reclaimRetiredMapsIfUnread()
+			{
+				//A reader that registers after the check loads m_map after it was replaced, so it cannot
+				//see any of the retired maps. This needs seq_cst on both sides.
+				if (!m_retiredMaps.isEmpty() && m_activeReaders.load(std::memory_order_seq_cst) == 0)
+				{
+					reclaimRetiredMaps();
+				}
+			}
+
+			void retireMap(Map* map)
+			{
+				if (!AllowsOptimisticReads::value)
+				{
+					delete map;
+					return;
+				}
+				m_retiredMaps.pushBack(map);
+				reclaimRetiredMapsIfUnread();
+			}
+
+			void beginWrite()
+			{
+				m_version.store(m_version.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_release);
+			}
+
+			void endWrite()
+			{
+				m_version.store(m_version.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+			}
+
+			Map* getMapForInsertion(const K& key)
+			{
+				reclaimRetiredMapsIfUnread();
+				Map* map = m_map.load(std::memory_order_relaxed);
+				if (map->getGrowthLeft() > 0 || map->contains(key))
+				{
+					return map;
+				}
+
+				//The HashMap would rehash in place. Readers may be inside it, so we replace it instead.
+				Map* biggerMap = new Map();
+				biggerMap->reserve(map->getLength() * 2 + 1);
+				map->forEach(
+					[&](const K& k, const V& v)
+					{
+						biggerMap->add(k, v);
+					});
+				m_map.store(biggerMap, std::memory_order_seq_cst);
+				retireMap(map);
+				return biggerMap;
+			}
+		};
+
+		Shard m_shards[AMOUNT_OF_SHARDS];
+		Hasher m_hasher;
+
+		Shard& getShard(const K& key)
+		{
+			//The HashMap uses the lowest bits of the hash, the shards use the highest.
+			return m_shards[(m_hasher(key) >> (sizeof(size_t) * 8 - 8)) & (AMOUNT_OF_SHARDS - 1)];
+		}
+
+		const Shard& getShard(const K& key) const
+		{
+			return m_shards[(m_hasher(key) >> (sizeof(size_t) * 8 - 8)) & (AMOUNT_OF_SHARDS - 1)];
+		}
+
+		bool getLocked(const Shard& shard, const K& key, V& out) const
+		{
+			std::lock_guard<std::mutex> lock(shard.m_mutex);
+			const V* found = shard.m_map.load(std::memory_order_relaxed)->find(key);
+			if (found == nullptr)
+			{
+				return false;
+			}
+			out = *found;
+			return true;
+		}
+
+		class ReaderRegistration
+		{
+		private:
+			const Shard& m_shard;
+
+		public:
+			explicit ReaderRegistration(const Shard& shard)
+				: m_shard(shard)
+			{
+				m_shard.m_activeReaders.fetch_add(1, std::memory_order_seq_cst);
+			}
+
+			ReaderRegistration(const ReaderRegistration& other) = delete;
+			ReaderRegistration& operator=(const ReaderRegistration& other) = delete;
+
+			~ReaderRegistration()
+			{
+				m_shard.m_activeReaders.fetch_sub(1, std::memory_order_release);
+			}
+		};
+
+		bool get(const Shard& shard, const K& key, V& out, std::true_type /*allowsOptimisticReads*/) const
+		{
+			static_assert(std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value, "Optimistic reads copy possibly torn keys and values!");
+			ReaderRegistration registration(shard);
+			for (size_t i = 0; i < CONCURRENT_HASH_MAP_OPTIMISTIC_RETRIES; i++)
+			{
+				const uint32_t versionBefore = shard.m_version.load(std::memory_order_acquire);
+				if (versionBefore & 1)
+				{
+					std::this_thread::yield();
+					continue;
+				}
+
+				//Racy on purpose, see the class comment. The copy is only used if the version did not change.
+				const V* found = shard.m_map.load(std::memory_order_seq_cst)->find(key);
+				typename std::aligned_storage<sizeof(V), alignof(V)>::type copy;
+				if (found != nullptr)
+				{
+					memcpy(&copy, found, sizeof(V));
+				}
+
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (shard.m_version.load(std::memory_order_relaxed) == versionBefore)
+				{
+					if (found == nullptr)
+					{
+						return false;
+					}
+					memcpy(bbe::addressOf(out), &copy, sizeof(V));
+					return true;
+				}
+			}
+			return getLocked(shard, key, out);
+		}
+
+		bool get(const Shard& shard, const K& key, V& out, std::false_type /*allowsOptimisticReads*/) const
+		{
+			return getLocked(shard, key, out);
+		}
+
+	public:
+		ConcurrentHashMap()
+		{
+			//do nothing
+		}
+
+		ConcurrentHashMap(const ConcurrentHashMap& other) = delete; //Copy Constructor
+		ConcurrentHashMap(ConcurrentHashMap&& other) = delete; //Move Constructor
+		ConcurrentHashMap& operator=(const ConcurrentHashMap& other) = delete; //Copy Assignment
+		ConcurrentHashMap& operator=(ConcurrentHashMap&& other) = delete; //Move Assignment
+
+		bool add(const K& key, const V& value)
+		{
+			Shard& shard = getShard(key);
+			std::lock_guard<std::mutex> lock(shard.m_mutex);
+			Map* map = shard.getMapForInsertion(key);
+			shard.beginWrite();
+			bool retVal = map->add(key, value);
+			shard.endWrite();
+			return retVal;
+		}
+
+		template <typename Callback>
+		void upsert(const K& key, Callback callback)
+		{
+			//Calls callback(V& value, bool isNew) while holding the lock of the shard.
+			//If the key was not present, value is default constructed before. The callback must not use
+			//this map. get, contains, add, upsert and remove may lock the same shard, and the thread would
+			//deadlock on its own lock.
+			Shard& shard = getShard(key);
+			std::lock_guard<std::mutex> lock(shard.m_mutex);
+			Map* map = shard.getMapForInsertion(key);
+			shard.beginWrite();
+			V* value = map->find(key);
+			const bool isNew = value == nullptr;
+			if (isNew)
+			{
+				value = bbe::addressOf((*map)[key]);
+			}
+			callback(*value, isNew);
+			shard.endWrite();
+		}
+
+		bool remove(const K& key)
+		{
+			Shard& shard = getShard(key);
+			std::lock_guard<std::mutex> lock(shard.m_mutex);
+			shard.beginWrite();
+			bool retVal = shard.m_map.load(std::memory_order_relaxed)->remove(key);
+			shard.endWrite();
+			return retVal;
+		}
+
+		bool get(const K& key, V& out) const
+		{
+			return get(getShard(key), key, out, AllowsOptimisticReads());
+		}
+
+		bool contains(const K& key) const
+		{
+			V dummy;
+			return get(key, dummy);
+		}
+
+		void clear()
+		{
+			for (size_t i = 0; i < AMOUNT_OF_SHARDS; i++)
+			{
+				std::lock_guard<std::mutex> lock(m_shards[i].m_mutex);
+				m_shards[i].beginWrite();
+				m_shards[i].m_map.load(std::memory_order_relaxed)->clear();
+				m_shards[i].endWrite();
+			}
+		}
+
+		template <typename Func>
+		void forEach(Func func)
+		{
+			//Locks one shard at a time, so the result is not a snapshot of the whole map.
+			for (size_t i = 0; i < AMOUNT_OF_SHARDS; i++)
+			{
+				std::lock_guard<std::mutex> lock(m_shards[i].m_mutex);
+				const Map* map = m_shards[i].m_map.load(std::memory_order_relaxed);
+				map->forEach(func);
+			}
+		}
+
+		size_t getLength()
+		{
+			size_t length = 0;
+			for (size_t i = 0; i < AMOUNT_OF_SHARDS; i++)
+			{
+				std::lock_guard<std::mutex> lock(m_shards[i].m_mutex);
+				length += m_shards[i].m_map.load(std::memory_order_relaxed)->getLength();
+			}
+			return length;
+		}
+
+		size_t getAmountOfRetiredMaps()
+		{
+			size_t amount = 0;
+			for (size_t i = 0; i < AMOUNT_OF_SHARDS; i++)
+			{
+				std::lock_guard<std::mutex> lock(m_shards[i].m_mutex);
+				amount += m_shards[i].m_retiredMaps.getLength();
+			}
+			return amount;
+		}
+
+		void reclaimRetiredMaps()
+		{
+			//Must only be called while no other thread accesses the ConcurrentHashMap.
+			for (size_t i = 0; i < AMOUNT_OF_SHARDS; i++)
+			{
+				std::lock_guard<std::mutex> lock(m_shards[i].m_mutex);
+				m_shards[i].reclaimRetiredMaps();
+			}
+		}
+	};
+}
\ No newline at end of file
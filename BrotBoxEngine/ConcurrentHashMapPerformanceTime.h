@@ -0,0 +1,103 @@
+#pragma once
+
+#include "ConcurrentHashMap.h"
+#include "HashMap.h"
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include "List.h"
+#include "StopWatch.h"
+
+namespace bbe
+{
+	namespace test
+	{
+		template <typename Func>
+		long long concurrentHashMapMeasureThreads(size_t amountOfThreads, Func func)
+		{
+			List<std::thread*> threads;
+			StopWatch sw;
+			for (size_t t = 0; t < amountOfThreads; t++)
+			{
+				threads.pushBack(new std::thread(func, t));
+			}
+			for (size_t t = 0; t < threads.getLength(); t++)
+			{
+				threads[t]->join();
+				delete threads[t];
+			}
+			return sw.getTimeExpiredMilliseconds();
+		}
+
+		void concurrentHashMapPrintThroughput()
+		{
+			//Every thread performs the same amount of operations, 90% reads and 10% upserts.
+			constexpr size_t amountOfKeys = 100000;
+			constexpr size_t amountOfOperationsPerThread = 4000000;
+			const size_t maxThreads = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 4;
+
+			while (true)
+			{
+				for (size_t amountOfThreads = 1; amountOfThreads <= maxThreads; amountOfThreads *= 2)
+				{
+					ConcurrentHashMap<size_t, size_t> concurrentMap;
+					HashMap<size_t, size_t> lockedMap;
+					std::mutex lockedMapMutex;
+					for (size_t i = 0; i < amountOfKeys; i++)
+					{
+						concurrentMap.add(i, i);
+						lockedMap.add(i, i);
+					}
+
+					long long timeConcurrent = concurrentHashMapMeasureThreads(amountOfThreads,
+						[&](size_t threadIndex)
+						{
+							size_t value = 0;
+							size_t key = threadIndex * 7919;
+							for (size_t i = 0; i < amountOfOperationsPerThread; i++)
+							{
+								key = (key + 104729) % amountOfKeys;
+								if (i % 10 == 0)
+								{
+									concurrentMap.upsert(key,
+										[](size_t& v, bool isNew)
+										{
+											v++;
+										});
+								}
+								else
+								{
+									concurrentMap.get(key, value);
+								}
+							}
+						});
+
+					long long timeLocked = concurrentHashMapMeasureThreads(amountOfThreads,
+						[&](size_t threadIndex)
+						{
+							size_t key = threadIndex * 7919;
+							for (size_t i = 0; i < amountOfOperationsPerThread; i++)
+							{
+								key = (key + 104729) % amountOfKeys;
+								std::lock_guard<std::mutex> lock(lockedMapMutex);
+								if (i % 10 == 0)
+								{
+									lockedMap[key]++;
+								}
+								else
+								{
+									lockedMap.find(key);
+								}
+							}
+						});
+
+					const double totalOperations = (double)(amountOfOperationsPerThread * amountOfThreads);
+					std::cout << "Threads: " << amountOfThreads << std::endl;
+					std::cout << "ConcurrentHashMap:   " << (totalOperations / (timeConcurrent + 1) / 1000.0) << " MOps/s" << std::endl;
+					std::cout << "HashMap with mutex:  " << (totalOperations / (timeLocked + 1) / 1000.0) << " MOps/s" << std::endl;
+				}
+				std::cout << std::endl;
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <atomic>
+#include "ConcurrentHashMap.h"
+#include "String.h"
+#include "UtilTest.h"
+#include <thread>
+
+namespace bbe
+{
+	namespace test
+	{
+		void testConcurrentHashMap()
+		{
+			{
+				ConcurrentHashMap<int, int> map;
+				int value = 0;
+				assertEquals(map.get(1, value), false);
+				assertEquals(map.add(1, 10), true);
+				assertEquals(map.add(1, 11), false);
+				assertEquals(map.get(1, value), true);
+				assertEquals(value, 11);
+				assertEquals(map.contains(2), false);
+
+				map.upsert(2,
+					[](int& v, bool isNew)
+					{
+						assertEquals(isNew, true);
+						assertEquals(v, 0);
+						v = 20;
+					});
+				map.upsert(2,
+					[](int& v, bool isNew)
+					{
+						assertEquals(isNew, false);
+						v++;
+					});
+				assertEquals(map.get(2, value), true);
+				assertEquals(value, 21);
+				assertEquals(map.getLength(), 2);
+				assertEquals(map.remove(1), true);
+				assertEquals(map.getLength(), 1);
+			}
+
+			{
+				constexpr int amountOfThreads = 4;
+				constexpr int amountOfKeys = 1000;
+				constexpr int amountOfIncrements = 20;
+				ConcurrentHashMap<int, int> map;
+				List<std::thread*> threads;
+				for (int t = 0; t < amountOfThreads; t++)
+				{
+					threads.pushBack(new std::thread(
+						[&]()
+						{
+							for (int i = 0; i < amountOfIncrements; i++)
+							{
+								for (int k = 0; k < amountOfKeys; k++)
+								{
+									map.upsert(k,
+										[](int& v, bool)
+										{
+											v++;
+										});
+									int value = 0;
+									assertEquals(map.get(k, value), true);
+									assertGreaterThan(value, 0);
+								}
+							}
+						}));
+				}
+				for (size_t t = 0; t < threads.getLength(); t++)
+				{
+					threads[t]->join();
+					delete threads[t];
+				}
+				assertEquals(map.getLength(), amountOfKeys);
+				for (int k = 0; k < amountOfKeys; k++)
+				{
+					int value = 0;
+					assertEquals(map.get(k, value), true);
+					assertEquals(value, amountOfThreads * amountOfIncrements);
+				}
+				map.reclaimRetiredMaps();
+			}
+
+			{
+				//Adding and removing keys leaves tombstones that use up the room of a map, so the shard
+				//keeps replacing it with a copy of the same size. The replaced maps must not pile up.
+				ConcurrentHashMap<int, int, Hash<int>, 1> map;
+				for (int i = 0; i < 200000; i++)
+				{
+					assertEquals(map.add(i, i), true);
+					if (i >= 1000)
+					{
+						assertEquals(map.remove(i - 1000), true);
+					}
+				}
+				assertEquals(map.getLength(), 1000);
+				assertEquals(map.getAmountOfRetiredMaps(), 0);
+			}
+
+			{
+				ConcurrentHashMap<int, int, Hash<int>, 1> map;
+				map.add(-1, -1);
+				std::atomic<bool> done(false);
+				List<std::thread*> readers;
+				for (int t = 0; t < 2; t++)
+				{
+					readers.pushBack(new std::thread(
+						[&]()
+						{
+							while (!done.load())
+							{
+								int value = 0;
+								assertEquals(map.get(-1, value), true);
+								assertEquals(value, -1);
+							}
+						}));
+				}
+				for (int i = 0; i < 200000; i++)
+				{
+					map.add(i, i);
+					if (i >= 1000)
+					{
+						map.remove(i - 1000);
+					}
+				}
+				done.store(true);
+				for (size_t t = 0; t < readers.getLength(); t++)
+				{
+					readers[t]->join();
+					delete readers[t];
+				}
+				map.add(-2, -2);
+				assertEquals(map.getAmountOfRetiredMaps(), 0);
+			}
+
+			{
+				ConcurrentHashMap<String, String> map;
+				map.add("Hugo", "AStr");
+				String adress;
+				assertEquals(map.get("Hugo", adress), true);
+				assertEquals(adress, "AStr");
+				assertEquals(map.get("Ebert", adress), false);
+				map.clear();
+				assertEquals(map.contains("Hugo"), false);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+#include "List.h"
+#include "UtilDebug.h"
+
+namespace bbe
+{
+	namespace INTERNAL
+	{
+		template <typename T>
+		class CopyOnWriteBuffer
+		{
+		public:
+			std::atomic<size_t> m_refCount;
+			List<T> m_list;
+
+			CopyOnWriteBuffer()
+				: m_refCount(1)
+			{
+				//do nothing
+			}
+
+			explicit CopyOnWriteBuffer(const List<T>& list)
+				: m_refCount(1), m_list(list)
+			{
+				//do nothing
+			}
+
+			explicit CopyOnWriteBuffer(List<T>&& list)
+				: m_refCount(1), m_list(std::move(list))
+			{
+				//do nothing
+			}
+		};
+	}
+
+	template <typename T>
+	class CopyOnWriteList
+	{
+		//List whose copies share one reference counted buffer. Copying only increments the counter, the
+		//elements are copied by the first modification of a shared buffer. The counter is atomic, so
+		//copies may be handed to and destroyed on other threads, as long as a single CopyOnWriteList
+		//object is not used by two threads at once. Reading never copies; modifications go through
+		//edit() or the functions that call it.
+	private:
+		INTERNAL::CopyOnWriteBuffer<T>* m_buffer = nullptr;
+
+		void releaseBuffer()
+		{
+			if (m_buffer != nullptr && m_buffer->m_refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				delete m_buffer;
+			}
+			m_buffer = nullptr;
+		}
+
+		void makeUnique()
+		{
+			if (m_buffer == nullptr)
+			{
+				m_buffer = new INTERNAL::CopyOnWriteBuffer<T>();
+			}
+			else if (m_buffer->m_refCount.load(std::memory_order_acquire) != 1)
+			{
+				INTERNAL::CopyOnWriteBuffer<T>* copy = new INTERNAL::CopyOnWriteBuffer<T>(m_buffer->m_list);
+				releaseBuffer();
+				m_buffer = copy;
+			}
+		}
+
+		const List<T>& getEmptyList() const
+		{
+			static const List<T> emptyList;
+			return emptyList;
+		}
+
+	public:
+		CopyOnWriteList()
+		{
+			//do nothing
+		}
+
+		explicit CopyOnWriteList(const List<T>& list)
+			: m_buffer(new INTERNAL::CopyOnWriteBuffer<T>(list))
+		{
+			//do nothing
+		}
+
+		explicit CopyOnWriteList(List<T>&& list)
+			: m_buffer(new INTERNAL::CopyOnWriteBuffer<T>(std::move(list)))
+		{
+			//do nothing
+		}
+
+		CopyOnWriteList(const CopyOnWriteList& other)
+			: m_buffer(other.m_buffer)
+		{
+			if (m_buffer != nullptr)
+			{
+				m_buffer->m_refCount.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		CopyOnWriteList(CopyOnWriteList&& other)
+			: m_buffer(other.m_buffer)
+		{
+			other.m_buffer = nullptr;
+		}
+
+		CopyOnWriteList& operator=(const CopyOnWriteList& other)
+		{
+			if (m_buffer == other.m_buffer)
+			{
+				return *this;
+			}
+			releaseBuffer();
+			m_buffer = other.m_buffer;
+			if (m_buffer != nullptr)
+			{
+				m_buffer->m_refCount.fetch_add(1, std::memory_order_relaxed);
+			}
+			return *this;
+		}
+
+		CopyOnWriteList& operator=(CopyOnWriteList&& other)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+			releaseBuffer();
+			m_buffer = other.m_buffer;
+			other.m_buffer = nullptr;
+			return *this;
+		}
+
+		~CopyOnWriteList()
+		{
+			releaseBuffer();
+		}
+
+		const List<T>& getList() const
+		{
+			if (m_buffer == nullptr)
+			{
+				return getEmptyList();
+			}
+			return m_buffer->m_list;
+		}
+
+		List<T>& edit()
+		{
+			//Copies the elements if the buffer is shared. The reference is invalidated by the next copy
+			//of this CopyOnWriteList, as the buffer is then shared again.
+			makeUnique();
+			return m_buffer->m_list;
+		}
+
+		bool isShared() const
+		{
+			return m_buffer != nullptr && m_buffer->m_refCount.load(std::memory_order_acquire) != 1;
+		}
+
+		size_t getLength() const
+		{
+			return getList().getLength();
+		}
+
+		bool isEmpty() const
+		{
+			return getList().isEmpty();
+		}
+
+		const T& operator[](size_t index) const
+		{
+			return getList()[index];
+		}
+
+		const T* getRaw() const
+		{
+			return getList().getRaw();
+		}
+
+		const T& first() const
+		{
+			if (isEmpty())
+			{
+				debugBreak();
+			}
+			return getList()[0];
+		}
+
+		const T& last() const
+		{
+			if (isEmpty())
+			{
+				debugBreak();
+			}
+			return getList()[getLength() - 1];
+		}
+
+		void set(size_t index, const T& value)
+		{
+			edit()[index] = value;
+		}
+
+		void set(size_t index, T&& value)
+		{
+			edit()[index] = std::move(value);
+		}
+
+		void pushBack(const T& value)
+		{
+			edit().pushBack(value);
+		}
+
+		void pushBack(T&& value)
+		{
+			edit().pushBack(std::move(value));
+		}
+
+		void popBack(size_t amount = 1)
+		{
+			edit().popBack(amount);
+		}
+
+		void clear()
+		{
+			//A shared buffer is not copied just to be cleared.
+			if (isShared())
+			{
+				releaseBuffer();
+			}
+			else if (m_buffer != nullptr)
+			{
+				m_buffer->m_list.clear();
+			}
+		}
+	};
+}
\ No newline at end of file
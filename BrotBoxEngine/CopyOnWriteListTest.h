@@ -0,0 +1,106 @@
+#pragma once
+
+#include <thread>
+#include "CopyOnWriteList.h"
+#include "List.h"
+#include "UtilTest.h"
+
+namespace bbe
+{
+	namespace test
+	{
+		void testCopyOnWriteList()
+		{
+			Person::resetTestStatistics();
+			{
+				CopyOnWriteList<Person> list;
+				assertEquals(list.getLength(), 0);
+				assertEquals(list.isEmpty(), true);
+				assertEquals(list.isShared(), false);
+				assertEquals(list.getRaw(), nullptr);
+
+				list.pushBack(Person("Name 1", "Addr 1", 1));
+				list.pushBack(Person("Name 2", "Addr 2", 2));
+				list.pushBack(Person("Name 3", "Addr 3", 3));
+				assertEquals(list.getLength(), 3);
+				assertEquals(list.first().age, 1);
+				assertEquals(list.last().age, 3);
+				assertEquals(Person::amountOfPersons, 3);
+
+				//Copies share the buffer.
+				CopyOnWriteList<Person> copy(list);
+				CopyOnWriteList<Person> assigned;
+				assigned = copy;
+				assertEquals(Person::amountOfPersons, 3);
+				assertEquals(Person::amountOfCopyConstructorCalls, 0);
+				assertEquals(copy.getRaw(), list.getRaw());
+				assertEquals(assigned.getRaw(), list.getRaw());
+				assertEquals(list.isShared(), true);
+				assertEquals(copy[1].name, "Name 2");
+
+				//The first modification copies the elements, the other copies keep the old ones.
+				copy.set(1, Person("Changed", "Changed", 20));
+				assertEquals(Person::amountOfCopyConstructorCalls, 3);
+				assertEquals(Person::amountOfPersons, 6);
+				assertEquals(copy[1].age, 20);
+				assertEquals(list[1].age, 2);
+				assertEquals(assigned[1].age, 2);
+				assertEquals(copy.isShared(), false);
+				assertEquals(list.isShared(), true);
+
+				//A buffer that is no longer shared is modified in place.
+				copy.pushBack(Person("Name 4", "Addr 4", 4));
+				assertEquals(Person::amountOfCopyConstructorCalls, 3);
+				assigned.clear();
+				assertEquals(assigned.getLength(), 0);
+				assertEquals(list.getLength(), 3);
+				assertEquals(list.isShared(), false);
+				const Person* raw = list.getRaw();
+				list.edit()[0].age = 10;
+				assertEquals(list.getRaw(), raw);
+				assertEquals(list[0].age, 10);
+				assertEquals(Person::amountOfCopyConstructorCalls, 3);
+
+				CopyOnWriteList<Person> moved(std::move(copy));
+				assertEquals(moved.getLength(), 4);
+				assertEquals(copy.getLength(), 0);
+				moved.popBack();
+				assertEquals(moved.getLength(), 3);
+				list = std::move(moved);
+				assertEquals(list[1].name, "Changed");
+				assertEquals(Person::amountOfPersons, 3);
+			}
+			Person::checkIfAllPersonsWereDestroyed();
+
+			{
+				List<int> source;
+				for (int i = 0; i < 100; i++)
+				{
+					source.pushBack(i);
+				}
+				const int* raw = source.getRaw();
+				CopyOnWriteList<int> list(std::move(source));
+				assertEquals(list.getRaw(), raw);
+				assertEquals(list.getList().getLength(), 100);
+
+				//Snapshots are handed to other threads while the original keeps changing.
+				for (int frame = 0; frame < 10; frame++)
+				{
+					CopyOnWriteList<int> snapshot = list;
+					int sum = 0;
+					std::thread renderThread([&sum, snapshot]()
+					{
+						for (size_t i = 0; i < snapshot.getLength(); i++)
+						{
+							sum += snapshot[i];
+						}
+					});
+					list.set(0, list[0] + 1);
+					renderThread.join();
+					assertEquals(sum, 4950 + frame);
+				}
+				assertEquals(list[0], 10);
+			}
+		}
+	}
+}
\ No newline at end of file
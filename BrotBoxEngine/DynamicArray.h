@@ -1,11 +1,16 @@
 #pragma once
 
 #include "Array.h"
+#include "ListChunk.h"
+#include "STLCapsule.h"
+#include <functional>
 
 namespace bbe
 {
-	template<typename T, bool keepSorted>
-	class List;
+	class Uninitialized
+	{
+		//Tag for constructors that only allocate memory.
+	};
 
 	template <typename T>
 	class DynamicArray
@@ -13,106 +18,172 @@ namespace bbe
 		//TODO use Allocator
 	private:
 
-		T* m_data;
+		INTERNAL::ListChunk<T>* m_data;
 		size_t m_size;
+
+		void destroy()
+		{
+			if (m_data != nullptr)
+			{
+				for (size_t i = 0; i < m_size; i++)
+				{
+					m_data[i].value.~T();
+				}
+				delete[] m_data;
+			}
+			m_data = nullptr;
+			m_size = 0;
+		}
+
 	public:
 		DynamicArray(size_t size)
 			: m_size(size)
 		{
-			//UNTESTED
-			m_data = new T[size];
+			m_data = new INTERNAL::ListChunk<T>[m_size];
+			for (size_t i = 0; i < m_size; i++)
+			{
+				new (bbe::addressOf(m_data[i].value)) T();
+			}
 		}
 
-		template <typename U, int size>
-		DynamicArray(Array<U, size> arr)
+		DynamicArray(size_t size, const T& fillValue)
 			: m_size(size)
 		{
-			//UNTESTED
-			m_data = new T[m_size];
-			for (int i = 0; i < size; i++)
+			m_data = new INTERNAL::ListChunk<T>[m_size];
+			for (size_t i = 0; i < m_size; i++)
 			{
-				m_data[i] = arr[i];
+				new (bbe::addressOf(m_data[i].value)) T(fillValue);
 			}
 		}
 
-		DynamicArray(List<T, true> list)
-			: m_size(list.getLength())
+		DynamicArray(size_t size, Uninitialized)
+			: m_size(size)
+		{
+			//Every element has to be constructed with emplace before it is used or the DynamicArray is destroyed.
+			m_data = new INTERNAL::ListChunk<T>[m_size];
+		}
+
+		template <typename U, int size>
+		DynamicArray(const Array<U, size>& arr)
+			: m_size(size)
 		{
 			//UNTESTED
-			m_data = new T[m_size];
-			for (int i = 0; i < m_size; i++)
+			m_data = new INTERNAL::ListChunk<T>[m_size];
+			for (size_t i = 0; i < m_size; i++)
 			{
-				m_data[i] = list[i];
+				new (bbe::addressOf(m_data[i].value)) T(arr[i]);
 			}
 		}
 
-		DynamicArray(List<T, false> list)
+		template <bool keepSorted>
+		DynamicArray(const List<T, keepSorted>& list)
 			: m_size(list.getLength())
 		{
-			//UNTESTED
-			//TODO basically this is a copy of above. Put into function!
-			m_data = new T[m_size];
-			for (int i = 0; i < m_size; i++)
+			m_data = new INTERNAL::ListChunk<T>[m_size];
+			for (size_t i = 0; i < m_size; i++)
 			{
-				m_data[i] = list[i];
+				new (bbe::addressOf(m_data[i].value)) T(list[i]);
 			}
 		}
 
+		template <bool keepSorted>
+		DynamicArray(List<T, keepSorted>&& list)
+			: DynamicArray(list.release())
+		{
+			//do nothing
+		}
+
+		DynamicArray(ListBuffer<T>&& buffer)
+			: m_data(nullptr), m_size(0)
+		{
+			adopt(std::move(buffer));
+		}
+
 		~DynamicArray()
 		{
-			//UNTESTED
-			delete [] m_data;
+			destroy();
 		}
 
 		DynamicArray(const DynamicArray&  other) //Copy Constructor
+			: m_size(other.m_size)
 		{
-			//UNTESTED
-			m_data = new T[other.m_size];
-			for (size_t i = 0; i < size; i++)
+			m_data = new INTERNAL::ListChunk<T>[m_size];
+			for (size_t i = 0; i < m_size; i++)
 			{
-				m_data[i] = other[i];
+				new (bbe::addressOf(m_data[i].value)) T(other[i]);
 			}
 		}
 		DynamicArray(DynamicArray&& other) //Move Constructor
+			: m_data(other.m_data), m_size(other.m_size)
 		{
-			//UNTESTED
-			m_data = other.m_data;
-			m_size = other.m_size;
 			other.m_data = nullptr;
 			other.m_size = 0;
 		}
 		DynamicArray& operator=(const DynamicArray&  other)  //Copy Assignment
 		{
-			//UNTESTED
-			delete[] m_data;
+			if (this == &other)
+			{
+				return *this;
+			}
+			destroy();
 
-			m_data = new T[other.m_size];
-			for (size_t i = 0; i < size; i++)
+			m_size = other.m_size;
+			m_data = new INTERNAL::ListChunk<T>[m_size];
+			for (size_t i = 0; i < m_size; i++)
 			{
-				m_data[i] = other[i];
+				new (bbe::addressOf(m_data[i].value)) T(other[i]);
 			}
+			return *this;
 		}
 		DynamicArray& operator=(DynamicArray&& other) //Move Assignment
 		{
-			//UNTESTED
-			delete[] m_data;
+			if (this == &other)
+			{
+				return *this;
+			}
+			destroy();
 
 			m_data = other.m_data;
 			m_size = other.m_size;
 			other.m_data = nullptr;
 			other.m_size = 0;
+			return *this;
+		}
+
+		ListBuffer<T> release()
+		{
+			//Hands the buffer over without touching the elements. The DynamicArray is empty afterwards.
+			//The capacity of the returned buffer is the length, as spare capacity is not tracked.
+			ListBuffer<T> retVal(m_data, m_size, m_size);
+			m_data = nullptr;
+			m_size = 0;
+			return retVal;
+		}
+
+		void adopt(ListBuffer<T>&& buffer)
+		{
+			//Takes over the buffer in O(1). Its spare capacity stays unused until the DynamicArray is destroyed.
+			destroy();
+			m_size = buffer.getLength();
+			m_data = buffer.takeData();
+		}
+
+		template <typename... arguments>
+		T& emplace(size_t index, arguments&&... args)
+		{
+			//Constructs the element at index in place. Only for arrays created with Uninitialized, the old
+			//element is not destroyed.
+			return *new (bbe::addressOf(m_data[index].value)) T(std::forward<arguments>(args)...);
 		}
 
 		T& operator[](size_t index)
 		{
-			//UNTESTED
-			return m_data[index];
+			return m_data[index].value;
 		}
 
 		const T& operator[](size_t index) const
 		{
-			//UNTESTED
-			return m_data[index];
+			return m_data[index].value;
 		}
 
 		size_t getLength() const
@@ -123,14 +194,32 @@ namespace bbe
 
 		T* getRaw()
 		{
-			//UNTESTED
-			return m_data;
+			return reinterpret_cast<T*>(m_data);
 		}
 
 		const T* getRaw() const
 		{
-			//UNTESTED
-			return m_data;
+			return reinterpret_cast<const T*>(m_data);
+		}
+
+		void sort()
+		{
+			sortSTL(getRaw(), getRaw() + m_size);
+		}
+
+		void sort(std::function<bool(const T&, const T&)> predicate)
+		{
+			sortSTL(getRaw(), getRaw() + m_size, predicate);
+		}
+
+		void sortParallel(size_t sequentialThreshold = SORT_PARALLEL_DEFAULT_THRESHOLD)
+		{
+			sortParallelSTL(getRaw(), getRaw() + m_size, std::less<T>(), sequentialThreshold);
+		}
+
+		void sortParallel(std::function<bool(const T&, const T&)> predicate, size_t sequentialThreshold = SORT_PARALLEL_DEFAULT_THRESHOLD)
+		{
+			sortParallelSTL(getRaw(), getRaw() + m_size, predicate, sequentialThreshold);
 		}
 	};
 }
\ No newline at end of file
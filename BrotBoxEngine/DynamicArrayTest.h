@@ -0,0 +1,202 @@
+#pragma once
+
+#include "DynamicArray.h"
+#include "List.h"
+#include "UtilTest.h"
+
+namespace bbe
+{
+	namespace test
+	{
+		void testDynamicArray()
+		{
+			Person::resetTestStatistics();
+
+			{
+				DynamicArray<Person> arr(3);
+				assertEquals(arr.getLength(), 3);
+				assertEquals(Person::amountOfDefaulConstructorCalls, 3);
+				arr[1].age = 5;
+				assertEquals(arr[1].age, 5);
+			}
+
+			Person::checkIfAllPersonsWereDestroyed();
+			Person::resetTestStatistics();
+
+			{
+				DynamicArray<Person> arr(4, Person("Name", "Addr", 7));
+				assertEquals(arr.getLength(), 4);
+				assertEquals(arr[3].age, 7);
+				assertEquals(Person::amountOfCopyConstructorCalls, 4);
+			}
+
+			Person::checkIfAllPersonsWereDestroyed();
+			Person::resetTestStatistics();
+
+			{
+				DynamicArray<Person> arr(3, Uninitialized());
+				assertEquals(Person::amountOfDefaulConstructorCalls, 0);
+				for (size_t i = 0; i < arr.getLength(); i++)
+				{
+					Person& p = arr.emplace(i, "Name", "Addr", (int)i);
+					assertEquals(p.age, (int)i);
+				}
+				assertEquals(Person::amountOfParameterConstructorCalls, 3);
+				assertEquals(Person::amountOfCopyAssignmentCalls, 0);
+				assertEquals(arr[2].age, 2);
+
+				DynamicArray<Person> copy(arr);
+				assertEquals(copy[1].age, 1);
+				assertEquals(Person::amountOfCopyConstructorCalls, 3);
+
+				DynamicArray<Person> moved(std::move(copy));
+				assertEquals(moved.getLength(), 3);
+				assertEquals(copy.getLength(), 0);
+				assertEquals(copy.getRaw(), nullptr);
+
+				copy = moved;
+				assertEquals(copy.getLength(), 3);
+				copy = std::move(arr);
+				assertEquals(arr.getLength(), 0);
+				assertEquals(copy[2].age, 2);
+			}
+
+			Person::checkIfAllPersonsWereDestroyed();
+			Person::resetTestStatistics();
+
+			{
+				List<Person> list;
+				list.pushBack(Person("Name 1", "Addr 1", 1));
+				list.pushBack(Person("Name 2", "Addr 2", 2));
+				Person* raw = list.getRaw();
+				const size_t personsBefore = Person::amountOfPersons;
+
+				DynamicArray<Person> copied(list);
+				assertEquals(copied.getLength(), 2);
+				assertEquals(copied[1].age, 2);
+				assertEquals(list.getLength(), 2);
+
+				//The rvalue constructor takes over the buffer without copying or moving a single element.
+				DynamicArray<Person> adopted(std::move(list));
+				assertEquals(adopted.getLength(), 2);
+				assertEquals(adopted.getRaw(), raw);
+				assertEquals(adopted[0].name, "Name 1");
+				assertEquals(list.getLength(), 0);
+				assertEquals(list.getRaw(), nullptr);
+				assertEquals(Person::amountOfPersons, personsBefore + 2);
+			}
+
+			Person::checkIfAllPersonsWereDestroyed();
+			Person::resetTestStatistics();
+
+			{
+				String s = "a,b,,c";
+				DynamicArray<String> parts = s.split(",");
+				assertEquals(parts.getLength(), 4);
+				assertEquals(parts[0], "a");
+				assertEquals(parts[2], "");
+				assertEquals(parts[3], "c");
+			}
+
+			Person::checkIfAllPersonsWereDestroyed();
+			Person::resetTestStatistics();
+
+			{
+				List<Person> list;
+				list.resizeCapacity(8);
+				list.pushBack(Person("Name 1", "Addr 1", 1));
+				list.pushBack(Person("Name 2", "Addr 2", 2));
+				list.pushBack(Person("Name 3", "Addr 3", 3));
+				Person* raw = list.getRaw();
+				const size_t personsBefore = Person::amountOfPersons;
+
+				ListBuffer<Person> buffer = list.release();
+				assertEquals(buffer.getLength(), 3);
+				assertEquals(buffer.getCapacity(), 8);
+				assertEquals(buffer.getRaw(), raw);
+				assertEquals(list.getLength(), 0);
+				assertEquals(list.getCapacity(), 0);
+
+				DynamicArray<Person> arr(std::move(buffer));
+				assertEquals(arr.getLength(), 3);
+				assertEquals(arr.getRaw(), raw);
+				assertEquals(buffer.getRaw(), nullptr);
+
+				List<Person> back(arr.release());
+				assertEquals(back.getLength(), 3);
+				assertEquals(back.getCapacity(), 3);
+				assertEquals(back.getRaw(), raw);
+				assertEquals(back[2].age, 3);
+				assertEquals(arr.getLength(), 0);
+				assertEquals(Person::amountOfPersons, personsBefore);
+				assertEquals(Person::amountOfMoveConstructorCalls, 3);
+				assertEquals(Person::amountOfCopyConstructorCalls, 0);
+
+				//Adopting into a List that already has elements destroys them first.
+				List<Person> target;
+				target.pushBack(Person("Old", "Old", 0));
+				target.adopt(back.release());
+				assertEquals(target.getLength(), 3);
+				assertEquals(target[0].name, "Name 1");
+				assertEquals(Person::amountOfPersons, personsBefore);
+
+				//A buffer that nobody adopts destroys its elements.
+				{
+					ListBuffer<Person> dropped = target.release();
+				}
+				assertEquals(Person::amountOfPersons, personsBefore - 3);
+			}
+
+			Person::checkIfAllPersonsWereDestroyed();
+
+			{
+				List<int, true> sorted;
+				List<int> unsorted;
+				unsorted.pushBack(3);
+				unsorted.pushBack(1);
+				unsorted.pushBack(2);
+				sorted.adopt(unsorted.release());
+				assertEquals(sorted[0], 1);
+				assertEquals(sorted[1], 2);
+				assertEquals(sorted[2], 3);
+			}
+
+			{
+				//Including the terminating 0 lets the String adopt the buffer without a copy.
+				const wchar_t* text = L"This text is too long for SSO";
+				const size_t length = wcslen(text);
+				DynamicArray<wchar_t> arr(length + 1);
+				wmemcpy(arr.getRaw(), text, length + 1);
+				const wchar_t* raw = arr.getRaw();
+				String s(std::move(arr));
+				assertEquals(s, text);
+				assertEquals(s.getLength(), length);
+				assertEquals(s.getRaw(), raw);
+				assertEquals(arr.getLength(), 0);
+
+				ListBuffer<wchar_t> buffer = s.release();
+				assertEquals(buffer.getRaw(), raw);
+				assertEquals(buffer.getLength(), length);
+				assertEquals(buffer.getRaw()[length], 0);
+				assertEquals(s, "");
+				assertEquals(s.getLength(), 0);
+
+				List<wchar_t> chars(std::move(buffer));
+				assertEquals(chars.getLength(), length);
+				chars.pushBack(L'!');
+				String t(chars.release());
+				assertEquals(t, L"This text is too long for SSO!");
+
+				DynamicArray<wchar_t> noTerminator(length, L'x');
+				String u(std::move(noTerminator));
+				assertEquals(u.getLength(), length);
+				assertEquals(u.getRaw()[length], 0);
+
+				String shortString = "short";
+				String v(shortString.release());
+				assertEquals(v, "short");
+				assertEquals(shortString, "");
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,456 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include "DynamicArray.h"
+#include "List.h"
+#include "String.h"
+#include "StringView.h"
+#include "UtilDebug.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace bbe
+{
+	namespace INTERNAL
+	{
+		//Layout of a flat file:
+		//  FlatFileHeader
+		//  the blobs of all entries, each starting at a multiple of FLAT_FILE_ALIGNMENT
+		//  the directory, one FlatFileEntry per entry
+		//Every position is an offset from the start of the file, so the mapping can live at any
+		//address. The numbers are stored in native byte order; a file written with the other byte
+		//order fails the version check.
+		static constexpr uint32_t FLAT_FILE_VERSION = 1;
+		static constexpr size_t FLAT_FILE_ALIGNMENT = 64;
+		static constexpr char FLAT_FILE_MAGIC[8] = { 'B', 'B', 'E', 'F', 'L', 'A', 'T', '\0' };
+
+		enum class FlatFileEntryKind : uint32_t
+		{
+			ARRAY = 1,
+			STRING = 2,
+		};
+
+		class FlatFileHeader
+		{
+		public:
+			char m_magic[8];
+			uint32_t m_version;
+			uint32_t m_amountOfEntries;
+			uint64_t m_directoryOffset;
+			uint64_t m_fileSize;
+		};
+
+		class FlatFileEntry
+		{
+		public:
+			uint64_t m_offset;
+			//Amount of elements. Strings are followed by a terminating 0 that is not counted.
+			uint64_t m_length;
+			uint32_t m_elementSize;
+			FlatFileEntryKind m_kind;
+		};
+
+		static_assert(sizeof(FlatFileHeader) == 32, "The FlatFileHeader must not contain padding!");
+		static_assert(sizeof(FlatFileEntry) == 24, "The FlatFileEntry must not contain padding!");
+	}
+
+	template <typename T>
+	class FlatArrayView
+	{
+		//Read only view of contiguous elements, for example an entry of a FlatFile, a List or a DynamicArray.
+		//It does not own the elements.
+	private:
+		const T* m_data;
+		size_t m_length;
+
+	public:
+		FlatArrayView()
+			: m_data(nullptr), m_length(0)
+		{
+			//do nothing
+		}
+
+		FlatArrayView(const T* data, size_t length)
+			: m_data(data), m_length(length)
+		{
+			//do nothing
+		}
+
+		template <bool keepSorted>
+		FlatArrayView(const List<T, keepSorted>& list)
+			: m_data(list.getRaw()), m_length(list.getLength())
+		{
+			//do nothing
+		}
+
+		FlatArrayView(const DynamicArray<T>& arr)
+			: m_data(arr.getRaw()), m_length(arr.getLength())
+		{
+			//do nothing
+		}
+
+		const T& operator[](size_t index) const
+		{
+			return m_data[index];
+		}
+
+		size_t getLength() const
+		{
+			return m_length;
+		}
+
+		bool isEmpty() const
+		{
+			return m_length == 0;
+		}
+
+		const T* getRaw() const
+		{
+			return m_data;
+		}
+
+		const T* begin() const
+		{
+			return m_data;
+		}
+
+		const T* end() const
+		{
+			return m_data + m_length;
+		}
+	};
+
+	class FlatFileWriter
+	{
+		//Collects Lists, DynamicArrays and Strings and writes them as a flat file that FlatFile maps
+		//back into memory. The add functions return the index under which FlatFile finds the entry.
+		//Only trivially copyable elements can be stored, as they are written byte by byte.
+	private:
+		List<uint8_t> m_data;
+		List<INTERNAL::FlatFileEntry> m_entries;
+
+		size_t appendBlob(const void* data, size_t sizeInBytes)
+		{
+			const size_t padding = (INTERNAL::FLAT_FILE_ALIGNMENT - m_data.getLength() % INTERNAL::FLAT_FILE_ALIGNMENT) % INTERNAL::FLAT_FILE_ALIGNMENT;
+			if (padding > 0)
+			{
+				m_data.pushBack(0, padding);
+			}
+			const size_t offset = m_data.getLength();
+			if (sizeInBytes > 0)
+			{
+				m_data.pushBack(0, sizeInBytes);
+				memcpy(m_data.getRaw() + offset, data, sizeInBytes);
+			}
+			return offset;
+		}
+
+		size_t addEntry(size_t offset, size_t length, size_t elementSize, INTERNAL::FlatFileEntryKind kind)
+		{
+			INTERNAL::FlatFileEntry entry;
+			entry.m_offset = offset;
+			entry.m_length = length;
+			entry.m_elementSize = (uint32_t)elementSize;
+			entry.m_kind = kind;
+			m_entries.pushBack(entry);
+			return m_entries.getLength() - 1;
+		}
+
+	public:
+		FlatFileWriter()
+		{
+			m_data.pushBack(0, sizeof(INTERNAL::FlatFileHeader));
+		}
+
+		template <typename T>
+		size_t addArray(const T* data, size_t length)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written to a flat file!");
+			static_assert(alignof(T) <= INTERNAL::FLAT_FILE_ALIGNMENT, "The alignment of T is too big for a flat file!");
+			const size_t offset = appendBlob(data, length * sizeof(T));
+			return addEntry(offset, length, sizeof(T), INTERNAL::FlatFileEntryKind::ARRAY);
+		}
+
+		template <typename T, bool keepSorted>
+		size_t addList(const List<T, keepSorted>& list)
+		{
+			return addArray(list.getRaw(), list.getLength());
+		}
+
+		template <typename T>
+		size_t addArray(const DynamicArray<T>& arr)
+		{
+			return addArray(arr.getRaw(), arr.getLength());
+		}
+
+		size_t addString(const String& string)
+		{
+			const size_t offset = appendBlob(string.getRaw(), (string.getLength() + 1) * sizeof(wchar_t));
+			return addEntry(offset, string.getLength(), sizeof(wchar_t), INTERNAL::FlatFileEntryKind::STRING);
+		}
+
+		size_t getAmountOfEntries() const
+		{
+			return m_entries.getLength();
+		}
+
+		bool writeToFile(const char* path)
+		{
+			//The directory is appended and the header filled in right before writing, so the writer
+			//can keep collecting entries and write again afterwards.
+			const size_t blobsEnd = m_data.getLength();
+			const size_t directoryOffset = appendBlob(m_entries.getRaw(), m_entries.getLength() * sizeof(INTERNAL::FlatFileEntry));
+
+			INTERNAL::FlatFileHeader header;
+			memcpy(header.m_magic, INTERNAL::FLAT_FILE_MAGIC, sizeof(header.m_magic));
+			header.m_version = INTERNAL::FLAT_FILE_VERSION;
+			header.m_amountOfEntries = (uint32_t)m_entries.getLength();
+			header.m_directoryOffset = directoryOffset;
+			header.m_fileSize = m_data.getLength();
+			memcpy(m_data.getRaw(), &header, sizeof(header));
+
+			std::ofstream file(path, std::ios::binary | std::ios::trunc);
+			bool success = false;
+			if (file)
+			{
+				file.write(reinterpret_cast<const char*>(m_data.getRaw()), m_data.getLength());
+				success = (bool)file;
+			}
+			m_data.popBack(m_data.getLength() - blobsEnd);
+			return success;
+		}
+	};
+
+	class FlatFile
+	{
+		//Read only mapping of a file written by FlatFileWriter. Opening maps the whole file and checks
+		//the header and the directory; the entries are then used in place, without parsing or copying.
+		//The views stay valid until the FlatFile is closed or destroyed.
+	private:
+		const uint8_t* m_data = nullptr;
+		size_t m_size = 0;
+#ifdef _WIN32
+		HANDLE m_file = INVALID_HANDLE_VALUE;
+		HANDLE m_mapping = nullptr;
+#endif
+
+		const INTERNAL::FlatFileEntry& getEntry(size_t index, size_t elementSize, INTERNAL::FlatFileEntryKind kind) const
+		{
+			if (!isOpen() || index >= getAmountOfEntries())
+			{
+				debugBreak();
+			}
+			const INTERNAL::FlatFileEntry& entry = getDirectory()[index];
+			if (entry.m_elementSize != elementSize || entry.m_kind != kind)
+			{
+				//The entry was written with a different type.
+				debugBreak();
+			}
+			return entry;
+		}
+
+		const INTERNAL::FlatFileHeader& getHeader() const
+		{
+			return *reinterpret_cast<const INTERNAL::FlatFileHeader*>(m_data);
+		}
+
+		const INTERNAL::FlatFileEntry* getDirectory() const
+		{
+			return reinterpret_cast<const INTERNAL::FlatFileEntry*>(m_data + getHeader().m_directoryOffset);
+		}
+
+		bool isValid() const
+		{
+			if (m_size < sizeof(INTERNAL::FlatFileHeader))
+			{
+				return false;
+			}
+			const INTERNAL::FlatFileHeader& header = getHeader();
+			if (memcmp(header.m_magic, INTERNAL::FLAT_FILE_MAGIC, sizeof(header.m_magic)) != 0
+				|| header.m_version != INTERNAL::FLAT_FILE_VERSION
+				|| header.m_fileSize != m_size
+				|| header.m_directoryOffset % INTERNAL::FLAT_FILE_ALIGNMENT != 0
+				|| header.m_directoryOffset > m_size
+				|| (m_size - header.m_directoryOffset) / sizeof(INTERNAL::FlatFileEntry) < header.m_amountOfEntries)
+			{
+				return false;
+			}
+
+			const INTERNAL::FlatFileEntry* directory = getDirectory();
+			for (size_t i = 0; i < header.m_amountOfEntries; i++)
+			{
+				const INTERNAL::FlatFileEntry& entry = directory[i];
+				const uint64_t length = entry.m_kind == INTERNAL::FlatFileEntryKind::STRING ? entry.m_length + 1 : entry.m_length;
+				if (entry.m_offset % INTERNAL::FLAT_FILE_ALIGNMENT != 0
+					|| entry.m_offset > header.m_directoryOffset
+					|| entry.m_length >= m_size
+					|| entry.m_elementSize == 0
+					|| (header.m_directoryOffset - entry.m_offset) / entry.m_elementSize < length)
+				{
+					return false;
+				}
+				if (entry.m_kind == INTERNAL::FlatFileEntryKind::STRING)
+				{
+					if (entry.m_elementSize != sizeof(wchar_t) || reinterpret_cast<const wchar_t*>(m_data + entry.m_offset)[entry.m_length] != 0)
+					{
+						return false;
+					}
+				}
+				else if (entry.m_kind != INTERNAL::FlatFileEntryKind::ARRAY)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+	public:
+		FlatFile()
+		{
+			//do nothing
+		}
+
+		explicit FlatFile(const char* path)
+		{
+			open(path);
+		}
+
+		FlatFile(const FlatFile& other) = delete;
+		FlatFile(FlatFile&& other) = delete;
+		FlatFile& operator=(const FlatFile& other) = delete;
+		FlatFile& operator=(FlatFile&& other) = delete;
+
+		~FlatFile()
+		{
+			close();
+		}
+
+		bool open(const char* path)
+		{
+			//Returns false if the file can not be mapped or was not written by a compatible FlatFileWriter.
+			close();
+#ifdef _WIN32
+			m_file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (m_file == INVALID_HANDLE_VALUE)
+			{
+				return false;
+			}
+			LARGE_INTEGER fileSize;
+			if (!GetFileSizeEx(m_file, &fileSize) || fileSize.QuadPart == 0)
+			{
+				close();
+				return false;
+			}
+			m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (m_mapping == nullptr)
+			{
+				close();
+				return false;
+			}
+			m_data = static_cast<const uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+			if (m_data == nullptr)
+			{
+				close();
+				return false;
+			}
+			m_size = (size_t)fileSize.QuadPart;
+#else
+			const int file = ::open(path, O_RDONLY);
+			if (file < 0)
+			{
+				return false;
+			}
+			struct stat fileStat;
+			if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+			{
+				::close(file);
+				return false;
+			}
+			void* mapping = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+			//The mapping keeps the file alive on its own.
+			::close(file);
+			if (mapping == MAP_FAILED)
+			{
+				return false;
+			}
+			m_data = static_cast<const uint8_t*>(mapping);
+			m_size = (size_t)fileStat.st_size;
+#endif
+			if (!isValid())
+			{
+				close();
+				return false;
+			}
+			return true;
+		}
+
+		void close()
+		{
+#ifdef _WIN32
+			if (m_data != nullptr)
+			{
+				UnmapViewOfFile(m_data);
+			}
+			if (m_mapping != nullptr)
+			{
+				CloseHandle(m_mapping);
+			}
+			if (m_file != INVALID_HANDLE_VALUE)
+			{
+				CloseHandle(m_file);
+			}
+			m_mapping = nullptr;
+			m_file = INVALID_HANDLE_VALUE;
+#else
+			if (m_data != nullptr)
+			{
+				munmap(const_cast<uint8_t*>(m_data), m_size);
+			}
+#endif
+			m_data = nullptr;
+			m_size = 0;
+		}
+
+		bool isOpen() const
+		{
+			return m_data != nullptr;
+		}
+
+		size_t getAmountOfEntries() const
+		{
+			if (!isOpen())
+			{
+				return 0;
+			}
+			return getHeader().m_amountOfEntries;
+		}
+
+		template <typename T>
+		FlatArrayView<T> getArray(size_t index) const
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read from a flat file!");
+			const INTERNAL::FlatFileEntry& entry = getEntry(index, sizeof(T), INTERNAL::FlatFileEntryKind::ARRAY);
+			return FlatArrayView<T>(reinterpret_cast<const T*>(m_data + entry.m_offset), (size_t)entry.m_length);
+		}
+
+		StringView getString(size_t index) const
+		{
+			//The text is followed by a terminating 0, so getRaw() of the view is a C string.
+			const INTERNAL::FlatFileEntry& entry = getEntry(index, sizeof(wchar_t), INTERNAL::FlatFileEntryKind::STRING);
+			return StringView(reinterpret_cast<const wchar_t*>(m_data + entry.m_offset), (size_t)entry.m_length);
+		}
+	};
+}
\ No newline at end of file
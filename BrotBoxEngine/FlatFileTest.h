@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstdio>
+#include <fstream>
+#include "FlatFile.h"
+#include "List.h"
+#include "String.h"
+#include "UtilTest.h"
+
+namespace bbe
+{
+	namespace test
+	{
+		class FlatFileTestVertex
+		{
+		public:
+			float x;
+			float y;
+			int32_t id;
+		};
+
+		void testFlatFile()
+		{
+			const char* path = "FlatFileTest.bbeflat";
+			{
+				List<int64_t> numbers;
+				for (int64_t i = 0; i < 1000; i++)
+				{
+					numbers.pushBack(i * i - 500);
+				}
+				List<FlatFileTestVertex> vertices;
+				for (int32_t i = 0; i < 10; i++)
+				{
+					FlatFileTestVertex vertex;
+					vertex.x = i * 0.5f;
+					vertex.y = -i * 0.25f;
+					vertex.id = i;
+					vertices.pushBack(vertex);
+				}
+				DynamicArray<uint8_t> bytes(3, 7);
+				List<double> empty;
+
+				FlatFileWriter writer;
+				assertEquals(writer.addList(numbers), 0);
+				assertEquals(writer.addString("A string that does not fit into the SSO storage"), 1);
+				assertEquals(writer.addArray(bytes), 2);
+				assertEquals(writer.addList(vertices), 3);
+				assertEquals(writer.addString(""), 4);
+				assertEquals(writer.addList(empty), 5);
+				assertEquals(writer.getAmountOfEntries(), 6);
+				assertEquals(writer.writeToFile(path), true);
+			}
+
+			{
+				FlatFile file(path);
+				assertEquals(file.isOpen(), true);
+				assertEquals(file.getAmountOfEntries(), 6);
+
+				FlatArrayView<int64_t> numbers = file.getArray<int64_t>(0);
+				assertEquals(numbers.getLength(), 1000);
+				assertEquals(numbers[0], -500);
+				assertEquals(numbers[999], 999 * 999 - 500);
+				assertEquals((size_t)numbers.getRaw() % alignof(int64_t), 0);
+				int64_t sum = 0;
+				for (int64_t number : numbers)
+				{
+					sum += number;
+				}
+				assertEquals(sum, (int64_t)332833500 - 500 * 1000);
+
+				StringView string = file.getString(1);
+				assertEquals(string.getLength(), 47);
+				assertEquals(string, L"A string that does not fit into the SSO storage");
+				assertEquals(string == String("A string that does not fit into the SSO storage"), true);
+				assertEquals(String(string), "A string that does not fit into the SSO storage");
+
+				FlatArrayView<uint8_t> bytes = file.getArray<uint8_t>(2);
+				assertEquals(bytes.getLength(), 3);
+				assertEquals(bytes[2], 7);
+
+				FlatArrayView<FlatFileTestVertex> vertices = file.getArray<FlatFileTestVertex>(3);
+				assertEquals(vertices.getLength(), 10);
+				assertEquals(vertices[4].x, 2.0f);
+				assertEquals(vertices[4].y, -1.0f);
+				assertEquals(vertices[9].id, 9);
+
+				assertEquals(file.getString(4).getLength(), 0);
+				assertEquals(file.getString(4), L"");
+				assertEquals(file.getArray<double>(5).isEmpty(), true);
+
+				file.close();
+				assertEquals(file.isOpen(), false);
+				assertEquals(file.getAmountOfEntries(), 0);
+			}
+
+			{
+				//Files that were not written by a FlatFileWriter are rejected.
+				{
+					std::ofstream garbage(path, std::ios::binary | std::ios::trunc);
+					garbage << "This is not a flat file, even though it is long enough for a header.";
+				}
+				FlatFile file;
+				assertEquals(file.open(path), false);
+				assertEquals(file.isOpen(), false);
+				assertEquals(file.open("ThisFileDoesNotExist.bbeflat"), false);
+			}
+
+			{
+				List<int32_t> list;
+				list.pushBack(1);
+				list.pushBack(2);
+				FlatArrayView<int32_t> view(list);
+				assertEquals(view.getLength(), 2);
+				assertEquals(view[1], 2);
+			}
+
+			remove(path);
+		}
+	}
+}
\ No newline at end of file
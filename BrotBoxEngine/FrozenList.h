@@ -0,0 +1,276 @@
+#pragma once
+
+#include <cstdint>
+#include "List.h"
+#include "UtilDebug.h"
+#include "UtilMath.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#define BBE_FROZENLIST_USE_PREFETCH
+#include <xmmintrin.h>
+#endif
+
+namespace bbe
+{
+	template <typename T>
+	class FrozenList
+	{
+		//Read only copy of a sorted List in Eytzinger layout: the element at index k (1 based) has its
+		//children at 2k and 2k+1, like in a binary heap. The first levels of the tree share a few cache
+		//lines, and the 16 possible descendants four levels below k are contiguous, so the search can
+		//prefetch them long before it needs them. Only operator< of T is used.
+		//find and contains work on the Eytzinger positions only. Sorted indices, as taken by operator[]
+		//and returned by lowerBound and upperBound, are converted in O(1) with a few bit operations
+		//instead of lookup tables, so they never cost an extra cache miss.
+	public:
+		static constexpr size_t FROZEN_LIST_BATCH_SIZE = 8;
+
+	private:
+		static constexpr size_t FROZEN_LIST_PREFETCH_DISTANCE = 16;
+
+		List<T> m_data;
+
+		static size_t getDepth(size_t k)
+		{
+			return 63 - countLeadingZeros((uint64_t)k);
+		}
+
+		//The tree is complete: every level but the last one is full and the last one is filled from the
+		//left. In the perfect tree with the same amount of levels, the node at depth d and offset j within
+		//its level has the sorted index (2j + 1) * 2^(lastDepth - d) - 1. The leaves of the last level
+		//have the even indices, so the missing leaves are the even indices from 2 * getLastLevelLength()
+		//on. Correcting for them converts both ways in O(1).
+
+		size_t getLastLevelLength() const
+		{
+			const size_t length = m_data.getLength();
+			return length - ((size_t)1 << getDepth(length)) + 1;
+		}
+
+		size_t toSortedIndex(size_t k) const
+		{
+			//k is 1 based.
+			const size_t depth = getDepth(k);
+			const size_t offset = k - ((size_t)1 << depth);
+			const size_t perfectIndex = ((2 * offset + 1) << (getDepth(m_data.getLength()) - depth)) - 1;
+			const size_t missingBefore = (perfectIndex + 1) / 2;
+			const size_t lastLevelLength = getLastLevelLength();
+			return missingBefore > lastLevelLength ? perfectIndex - (missingBefore - lastLevelLength) : perfectIndex;
+		}
+
+		size_t toEytzingerPosition(size_t sortedIndex) const
+		{
+			//Returns the 1 based position of the element with the given sorted index.
+			const size_t lastLevelLength = getLastLevelLength();
+			const size_t perfectIndex = sortedIndex < 2 * lastLevelLength ? sortedIndex : 2 * sortedIndex - 2 * lastLevelLength + 1;
+			const size_t levelsBelow = countTrailingZeros((uint64_t)(perfectIndex + 1));
+			const size_t depth = getDepth(m_data.getLength()) - levelsBelow;
+			return ((size_t)1 << depth) + ((perfectIndex + 1) >> (levelsBelow + 1));
+		}
+
+		void fill(const T* sorted, size_t& sortedIndex, size_t k)
+		{
+			//In order traversal of the implicit tree visits the positions in sorted order.
+			if (k <= m_data.getLength())
+			{
+				fill(sorted, sortedIndex, 2 * k);
+				m_data[k - 1] = sorted[sortedIndex++];
+				fill(sorted, sortedIndex, 2 * k + 1);
+			}
+		}
+
+		void prefetch(size_t k) const
+		{
+#ifdef BBE_FROZENLIST_USE_PREFETCH
+			//Computed as an integer, so that we never form a pointer past the end of m_data.
+			_mm_prefetch(reinterpret_cast<const char*>(reinterpret_cast<uintptr_t>(m_data.getRaw()) + (k * FROZEN_LIST_PREFETCH_DISTANCE - 1) * sizeof(T)), _MM_HINT_T0);
+#endif
+		}
+
+		static size_t finishSearch(size_t k)
+		{
+			//k walked right after every element that was smaller than the value. The last left turn
+			//is the lower bound, it is found by dropping the trailing right turns and the left turn.
+			//Returns its 1 based position, or 0 if every element was smaller.
+			return k >> (countTrailingZeros((uint64_t)~k) + 1);
+		}
+
+		size_t toSortedIndexOrLength(size_t k) const
+		{
+			return k == 0 ? m_data.getLength() : toSortedIndex(k);
+		}
+
+		size_t getPredecessor(size_t k) const
+		{
+			//1 based position of the element before k in sorted order, or 0. k == 0 stands for the end.
+			const size_t length = m_data.getLength();
+			if (k == 0 || 2 * k <= length)
+			{
+				//The last element of the left subtree, or of the whole tree for the end.
+				size_t predecessor = k == 0 ? 1 : 2 * k;
+				if (predecessor > length)
+				{
+					return 0;
+				}
+				while (2 * predecessor + 1 <= length)
+				{
+					predecessor = 2 * predecessor + 1;
+				}
+				return predecessor;
+			}
+			//The closest ancestor that k is right of.
+			while (k > 1 && (k & 1) == 0)
+			{
+				k >>= 1;
+			}
+			return k >> 1;
+		}
+
+		size_t searchLowerBound(const T& val) const
+		{
+			const size_t length = m_data.getLength();
+			const T* data = m_data.getRaw();
+			size_t k = 1;
+			while (k <= length)
+			{
+				prefetch(k);
+				k = 2 * k + (data[k - 1] < val ? 1 : 0);
+			}
+			return finishSearch(k);
+		}
+
+		size_t searchUpperBound(const T& val) const
+		{
+			const size_t length = m_data.getLength();
+			const T* data = m_data.getRaw();
+			size_t k = 1;
+			while (k <= length)
+			{
+				prefetch(k);
+				k = 2 * k + (val < data[k - 1] ? 0 : 1);
+			}
+			return finishSearch(k);
+		}
+
+	public:
+		FrozenList()
+		{
+			//do nothing
+		}
+
+		template <bool keepSorted>
+		explicit FrozenList(const List<T, keepSorted>& sorted)
+		{
+			//The List must be sorted ascending. Lists with keepSorted == true always are.
+			for (size_t i = 1; i < sorted.getLength(); i++)
+			{
+				if (sorted[i] < sorted[i - 1])
+				{
+					debugBreak();
+				}
+			}
+
+			if (sorted.isEmpty())
+			{
+				return;
+			}
+			m_data.resizeCapacity(sorted.getLength());
+			for (size_t i = 0; i < sorted.getLength(); i++)
+			{
+				m_data.pushBack(sorted[0]);
+			}
+			size_t sortedIndex = 0;
+			fill(sorted.getRaw(), sortedIndex, 1);
+		}
+
+		size_t getLength() const
+		{
+			return m_data.getLength();
+		}
+
+		bool isEmpty() const
+		{
+			return m_data.isEmpty();
+		}
+
+		const T& operator[](size_t sortedIndex) const
+		{
+			//Access by the index the element had in the sorted List.
+			return m_data[toEytzingerPosition(sortedIndex) - 1];
+		}
+
+		size_t lowerBound(const T& val) const
+		{
+			//Returns the sorted index of the first element that is not smaller than val, or getLength().
+			return toSortedIndexOrLength(searchLowerBound(val));
+		}
+
+		size_t upperBound(const T& val) const
+		{
+			//Returns the sorted index of the first element that is bigger than val, or getLength().
+			return toSortedIndexOrLength(searchUpperBound(val));
+		}
+
+		void lowerBoundBatch(const T* values, size_t* outSortedIndices, size_t amount) const
+		{
+			//Same as calling lowerBound for every value, but FROZEN_LIST_BATCH_SIZE searches descend the
+			//tree together, so the cache misses of one search overlap with those of the others.
+			const size_t length = m_data.getLength();
+			const T* data = m_data.getRaw();
+			for (size_t start = 0; start < amount; start += FROZEN_LIST_BATCH_SIZE)
+			{
+				const size_t batchSize = amount - start < FROZEN_LIST_BATCH_SIZE ? amount - start : FROZEN_LIST_BATCH_SIZE;
+				size_t k[FROZEN_LIST_BATCH_SIZE];
+				for (size_t i = 0; i < batchSize; i++)
+				{
+					k[i] = 1;
+				}
+
+				bool active = length > 0;
+				while (active)
+				{
+					active = false;
+					for (size_t i = 0; i < batchSize; i++)
+					{
+						if (k[i] <= length)
+						{
+							prefetch(k[i]);
+							k[i] = 2 * k[i] + (data[k[i] - 1] < values[start + i] ? 1 : 0);
+							active = true;
+						}
+					}
+				}
+
+				for (size_t i = 0; i < batchSize; i++)
+				{
+					outSortedIndices[start + i] = toSortedIndexOrLength(finishSearch(k[i]));
+				}
+			}
+		}
+
+		const T* find(const T& val) const
+		{
+			const size_t k = searchLowerBound(val);
+			if (k == 0 || val < m_data[k - 1])
+			{
+				return nullptr;
+			}
+			return bbe::addressOf(m_data[k - 1]);
+		}
+
+		bool contains(const T& val) const
+		{
+			return find(val) != nullptr;
+		}
+
+		void getNeighbors(const T& val, const T*& leftNeighbor, const T*& rightNeighbor) const
+		{
+			//Like List::getNeighbors: the last element that is not bigger than val and the first element
+			//that is bigger than val. Missing neighbors are nullptr.
+			const size_t right = searchUpperBound(val);
+			const size_t left = getPredecessor(right);
+			leftNeighbor = left == 0 ? nullptr : bbe::addressOf(m_data[left - 1]);
+			rightNeighbor = right == 0 ? nullptr : bbe::addressOf(m_data[right - 1]);
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "FrozenList.h"
+#include "List.h"
+#include "UtilTest.h"
+
+namespace bbe
+{
+	namespace test
+	{
+		void testFrozenList()
+		{
+			{
+				FrozenList<int> empty;
+				assertEquals(empty.getLength(), 0);
+				assertEquals(empty.isEmpty(), true);
+				assertEquals(empty.lowerBound(5), 0);
+				assertEquals(empty.find(5), nullptr);
+			}
+
+			for (int length = 1; length < 100; length++)
+			{
+				List<int> sorted;
+				for (int i = 0; i < length; i++)
+				{
+					sorted.pushBack(i * 2);
+				}
+				FrozenList<int> frozen(sorted);
+				assertEquals(frozen.getLength(), length);
+				for (int i = 0; i < length; i++)
+				{
+					assertEquals(frozen[i], sorted[i]);
+				}
+				for (int i = -1; i <= length * 2; i++)
+				{
+					const size_t upperBound = i < 0 ? 0 : (size_t)(i / 2 + 1 < length ? i / 2 + 1 : length);
+					assertEquals(frozen.upperBound(i), upperBound);
+					const int* found = frozen.find(i);
+					if (found != nullptr)
+					{
+						assertEquals(*found, i);
+					}
+					const int* left = nullptr;
+					const int* right = nullptr;
+					frozen.getNeighbors(i, left, right);
+					if (upperBound == 0)
+					{
+						assertEquals(left, nullptr);
+					}
+					else
+					{
+						assertEquals(*left, sorted[upperBound - 1]);
+					}
+					if (upperBound == (size_t)length)
+					{
+						assertEquals(right, nullptr);
+					}
+					else
+					{
+						assertEquals(*right, sorted[upperBound]);
+					}
+				}
+
+				List<int> queries;
+				List<size_t> expected;
+				for (int i = -1; i <= length * 2; i++)
+				{
+					const size_t lowerBound = i < 0 ? 0 : (size_t)((i + 1) / 2);
+					assertEquals(frozen.lowerBound(i), lowerBound);
+					assertEquals(frozen[i < 0 ? 0 : (i / 2 < length ? i / 2 : length - 1)], sorted[i < 0 ? 0 : (i / 2 < length ? i / 2 : length - 1)]);
+					assertEquals(frozen.contains(i), i >= 0 && i % 2 == 0 && i < length * 2);
+					queries.pushBack(i);
+					expected.pushBack(lowerBound);
+				}
+
+				List<size_t> results;
+				for (size_t i = 0; i < queries.getLength(); i++)
+				{
+					results.pushBack(0);
+				}
+				frozen.lowerBoundBatch(queries.getRaw(), results.getRaw(), queries.getLength());
+				for (size_t i = 0; i < queries.getLength(); i++)
+				{
+					assertEquals(results[i], expected[i]);
+				}
+			}
+
+			{
+				List<int, true> sorted;
+				sorted.pushBackAll(5, 1, 9, 5, 3);
+				FrozenList<int> frozen(sorted);
+				assertEquals(frozen[0], 1);
+				assertEquals(frozen[2], 5);
+				assertEquals(frozen[4], 9);
+				assertEquals(frozen.lowerBound(5), 2);
+				assertEquals(frozen.upperBound(5), 4);
+
+				const int* left = nullptr;
+				const int* right = nullptr;
+				frozen.getNeighbors(5, left, right);
+				assertEquals(*left, 5);
+				assertEquals(*right, 9);
+				frozen.getNeighbors(0, left, right);
+				assertEquals(left, nullptr);
+				assertEquals(*right, 1);
+				frozen.getNeighbors(10, left, right);
+				assertEquals(*left, 9);
+				assertEquals(right, nullptr);
+			}
+		}
+	}
+}
\ No newline at end of file
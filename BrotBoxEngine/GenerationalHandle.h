@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace bbe
+{
+	class GenerationalHandle
+	{
+		//Handle into a container whose slots are reused. The generation of a slot is incremented
+		//whenever its element is removed, so an old handle to a reused slot no longer matches.
+	public:
+		uint32_t m_index;
+		uint32_t m_generation;
+
+		GenerationalHandle()
+			: m_index(std::numeric_limits<uint32_t>::max()), m_generation(0)
+		{
+			//do nothing
+		}
+
+		GenerationalHandle(uint32_t index, uint32_t generation)
+			: m_index(index), m_generation(generation)
+		{
+			//do nothing
+		}
+
+		bool operator==(const GenerationalHandle& other) const
+		{
+			return m_index == other.m_index && m_generation == other.m_generation;
+		}
+
+		bool operator!=(const GenerationalHandle& other) const
+		{
+			return !operator==(other);
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include "DynamicArray.h"
+#include "List.h"
+#include "String.h"
+#include "StringView.h"
+#include "UtilHash.h"
+
+namespace bbe
+{
+	namespace INTERNAL
+	{
+		template <typename T>
+		size_t hashValue(const T& t, std::true_type /*isIntegralOrPointer*/)
+		{
+			return (size_t)hashMix((uint64_t)t);
+		}
+
+		template <typename T>
+		size_t hashValue(const T& t, std::false_type /*isIntegralOrPointer*/)
+		{
+			return (size_t)hashMix((uint64_t)std::hash<T>()(t));
+		}
+	}
+
+	template <typename T>
+	class Hash
+	{
+	public:
+		size_t operator()(const T& t) const
+		{
+			return INTERNAL::hashValue(t, std::integral_constant<bool, std::is_integral<T>::value || std::is_enum<T>::value>());
+		}
+	};
+
+	template <typename T>
+	class Hash<T*>
+	{
+	public:
+		size_t operator()(T* t) const
+		{
+			return (size_t)hashMix((uint64_t)(uintptr_t)t);
+		}
+	};
+
+	template <>
+	class Hash<StringView>
+	{
+	public:
+		size_t operator()(const StringView& t) const
+		{
+			return (size_t)hashBytes(t.getRaw(), t.getLength() * sizeof(wchar_t));
+		}
+	};
+
+	template <>
+	class Hash<String>
+	{
+	public:
+		size_t operator()(const String& t) const
+		{
+			//Cached in the String, equal to the hash of its StringView.
+			return t.getHash();
+		}
+	};
+
+	namespace INTERNAL
+	{
+		template <typename T>
+		size_t hashSequence(const T* data, size_t length, std::true_type /*isIntegralOrEnum*/)
+		{
+			//Integers have no padding, so equal elements have equal bytes.
+			return (size_t)hashBytes(data, length * sizeof(T));
+		}
+
+		template <typename T>
+		size_t hashSequence(const T* data, size_t length, std::false_type /*isIntegralOrEnum*/)
+		{
+			uint64_t hash = length;
+			Hash<T> hasher;
+			for (size_t i = 0; i < length; i++)
+			{
+				hash = hashCombine(hash, hasher(data[i]));
+			}
+			return (size_t)hash;
+		}
+
+		template <typename T>
+		size_t hashSequence(const T* data, size_t length)
+		{
+			return hashSequence(data, length, std::integral_constant<bool, std::is_integral<T>::value || std::is_enum<T>::value>());
+		}
+	}
+
+	template <typename T, bool keepSorted>
+	class Hash<List<T, keepSorted>>
+	{
+	public:
+		size_t operator()(const List<T, keepSorted>& t) const
+		{
+			return INTERNAL::hashSequence(t.getRaw(), t.getLength());
+		}
+	};
+
+	template <typename T>
+	class Hash<DynamicArray<T>>
+	{
+	public:
+		size_t operator()(const DynamicArray<T>& t) const
+		{
+			return INTERNAL::hashSequence(t.getRaw(), t.getLength());
+		}
+	};
+}
\ No newline at end of file
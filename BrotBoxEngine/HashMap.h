@@ -0,0 +1,568 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include "DataType.h"
+#include "Hash.h"
+#include "STLAllocator.h"
+#include "STLCapsule.h"
+#include "UtilMath.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define BBE_HASHMAP_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace bbe
+{
+	namespace INTERNAL
+	{
+		//Control bytes of the HashMap. Full slots store the lower 7 bits of their hash,
+		//so a full slot never has the highest bit set while empty and deleted slots do.
+		static constexpr int8_t HASHMAP_CTRL_EMPTY = -128;
+		static constexpr int8_t HASHMAP_CTRL_DELETED = -2;
+		static constexpr size_t HASHMAP_GROUP_WIDTH = 16;
+
+		class HashMapGroup
+		{
+		private:
+#ifdef BBE_HASHMAP_USE_SSE2
+			__m128i m_ctrl;
+#else
+			const int8_t* m_ctrl;
+#endif
+
+		public:
+			explicit HashMapGroup(const int8_t* ctrl)
+			{
+#ifdef BBE_HASHMAP_USE_SSE2
+				m_ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+				m_ctrl = ctrl;
+#endif
+			}
+
+			uint32_t match(int8_t h2) const
+			{
+#ifdef BBE_HASHMAP_USE_SSE2
+				return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_ctrl));
+#else
+				uint32_t mask = 0;
+				for (size_t i = 0; i < HASHMAP_GROUP_WIDTH; i++)
+				{
+					if (m_ctrl[i] == h2)
+					{
+						mask |= 1u << i;
+					}
+				}
+				return mask;
+#endif
+			}
+
+			uint32_t matchEmpty() const
+			{
+				return match(HASHMAP_CTRL_EMPTY);
+			}
+
+			uint32_t matchEmptyOrDeleted() const
+			{
+#ifdef BBE_HASHMAP_USE_SSE2
+				return (uint32_t)_mm_movemask_epi8(m_ctrl);
+#else
+				uint32_t mask = 0;
+				for (size_t i = 0; i < HASHMAP_GROUP_WIDTH; i++)
+				{
+					if (m_ctrl[i] < 0)
+					{
+						mask |= 1u << i;
+					}
+				}
+				return mask;
+#endif
+			}
+		};
+
+		template <typename K, typename V>
+		class HashMapEntry
+		{
+		public:
+			K key;
+			V value;
+
+			template <typename KK, typename... arguments>
+			HashMapEntry(KK&& key, arguments&&... args)
+				: key(std::forward<KK>(key)), value(std::forward<arguments>(args)...)
+			{
+				//do nothing
+			}
+		};
+
+		template <typename K, typename V>
+		union HashMapSlot
+		{
+			//same trick as the ListChunk, the constructor of the entry is only called on insertion
+			HashMapEntry<K, V> entry;
+
+			HashMapSlot() {}
+			~HashMapSlot() {}
+		};
+	}
+
+	template <typename K, typename V, typename Hasher = Hash<K>, typename Allocator = STLAllocator<byte>>
+	class HashMap
+	{
+		//Open addressing hash map in the style of Googles SwissTable. The slots are split into
+		//groups of 16 whose control bytes are compared against the hash in a single SSE2 instruction.
+	private:
+		typedef INTERNAL::HashMapEntry<K, V> Entry;
+		typedef INTERNAL::HashMapSlot<K, V> Slot;
+		static_assert(alignof(Slot) <= alignof(std::max_align_t), "HashMap does not support over aligned keys or values!");
+
+		int8_t* m_ctrl = nullptr;
+		Slot* m_slots = nullptr;
+		size_t m_capacity = 0;
+		size_t m_length = 0;
+		size_t m_growthLeft = 0;
+
+		Hasher m_hasher;
+		Allocator* m_parentAllocator = nullptr;
+		bool m_needsToDeleteParentAllocator = false;
+
+		static size_t getMaxLoad(size_t capacity)
+		{
+			return capacity - capacity / 8;
+		}
+
+		static size_t getAllocationSize(size_t capacity)
+		{
+			return nextMultiple(alignof(Slot), capacity) + capacity * sizeof(Slot);
+		}
+
+		static int8_t getH2(size_t hash)
+		{
+			return (int8_t)(hash & 0x7F);
+		}
+
+		static size_t getH1(size_t hash)
+		{
+			return hash >> 7;
+		}
+
+		void initParentAllocator(Allocator* parentAllocator)
+		{
+			m_parentAllocator = parentAllocator;
+			if (m_parentAllocator == nullptr)
+			{
+				m_parentAllocator = new Allocator();
+				m_needsToDeleteParentAllocator = true;
+			}
+		}
+
+		void allocate(size_t capacity)
+		{
+			byte* data = m_parentAllocator->allocate(getAllocationSize(capacity));
+			m_ctrl = reinterpret_cast<int8_t*>(data);
+			m_slots = reinterpret_cast<Slot*>(data + nextMultiple(alignof(Slot), capacity));
+			m_capacity = capacity;
+			m_growthLeft = getMaxLoad(capacity) - m_length;
+			memset(m_ctrl, (uint8_t)INTERNAL::HASHMAP_CTRL_EMPTY, capacity);
+		}
+
+		void deallocate()
+		{
+			if (m_ctrl != nullptr)
+			{
+				m_parentAllocator->deallocate(reinterpret_cast<byte*>(m_ctrl), getAllocationSize(m_capacity));
+			}
+			m_ctrl = nullptr;
+			m_slots = nullptr;
+			m_capacity = 0;
+			m_growthLeft = 0;
+		}
+
+		void destroyAll()
+		{
+			for (size_t i = 0; i < m_capacity; i++)
+			{
+				if (m_ctrl[i] >= 0)
+				{
+					bbe::addressOf(m_slots[i].entry)->~Entry();
+					m_ctrl[i] = INTERNAL::HASHMAP_CTRL_EMPTY;
+				}
+			}
+			m_length = 0;
+			if (m_capacity > 0)
+			{
+				m_growthLeft = getMaxLoad(m_capacity);
+			}
+		}
+
+		size_t findIndex(const K& key, size_t hash) const
+		{
+			if (m_capacity == 0)
+			{
+				return m_capacity;
+			}
+			const size_t groupMask = m_capacity / INTERNAL::HASHMAP_GROUP_WIDTH - 1;
+			const int8_t h2 = getH2(hash);
+			size_t group = getH1(hash) & groupMask;
+			for (size_t probe = 1; ; probe++)
+			{
+				const size_t groupStart = group * INTERNAL::HASHMAP_GROUP_WIDTH;
+				INTERNAL::HashMapGroup g(m_ctrl + groupStart);
+				uint32_t matches = g.match(h2);
+				while (matches != 0)
+				{
+					const size_t index = groupStart + countTrailingZeros(matches);
+					if (m_slots[index].entry.key == key)
+					{
+						return index;
+					}
+					matches &= matches - 1;
+				}
+				if (g.matchEmpty() != 0 || probe > groupMask)
+				{
+					return m_capacity;
+				}
+				group = (group + probe) & groupMask;
+			}
+		}
+
+		size_t findFirstNonFull(size_t hash) const
+		{
+			const size_t groupMask = m_capacity / INTERNAL::HASHMAP_GROUP_WIDTH - 1;
+			size_t group = getH1(hash) & groupMask;
+			for (size_t probe = 1; ; probe++)
+			{
+				const size_t groupStart = group * INTERNAL::HASHMAP_GROUP_WIDTH;
+				uint32_t mask = INTERNAL::HashMapGroup(m_ctrl + groupStart).matchEmptyOrDeleted();
+				if (mask != 0)
+				{
+					return groupStart + countTrailingZeros(mask);
+				}
+				group = (group + probe) & groupMask;
+			}
+		}
+
+		void rehash(size_t newCapacity)
+		{
+			int8_t* oldCtrl = m_ctrl;
+			Slot* oldSlots = m_slots;
+			size_t oldCapacity = m_capacity;
+
+			allocate(newCapacity);
+			for (size_t i = 0; i < oldCapacity; i++)
+			{
+				if (oldCtrl[i] >= 0)
+				{
+					const size_t hash = m_hasher(oldSlots[i].entry.key);
+					const size_t index = findFirstNonFull(hash);
+					m_ctrl[index] = getH2(hash);
+					new (bbe::addressOf(m_slots[index].entry)) Entry(std::move(oldSlots[i].entry));
+					bbe::addressOf(oldSlots[i].entry)->~Entry();
+				}
+			}
+			m_growthLeft = getMaxLoad(m_capacity) - m_length;
+
+			if (oldCtrl != nullptr)
+			{
+				m_parentAllocator->deallocate(reinterpret_cast<byte*>(oldCtrl), getAllocationSize(oldCapacity));
+			}
+		}
+
+		void makeRoomForInsertion()
+		{
+			if (m_capacity == 0)
+			{
+				rehash(INTERNAL::HASHMAP_GROUP_WIDTH);
+			}
+			else if (m_length <= getMaxLoad(m_capacity) / 2)
+			{
+				//Most of the used up growth are tombstones. Cleaning them up is enough.
+				rehash(m_capacity);
+			}
+			else
+			{
+				rehash(m_capacity * 2);
+			}
+		}
+
+		template <typename KK, typename... arguments>
+		size_t insertNew(size_t hash, KK&& key, arguments&&... args)
+		{
+			if (m_capacity == 0)
+			{
+				makeRoomForInsertion();
+			}
+			size_t index = findFirstNonFull(hash);
+			if (m_growthLeft == 0 && m_ctrl[index] == INTERNAL::HASHMAP_CTRL_EMPTY)
+			{
+				makeRoomForInsertion();
+				index = findFirstNonFull(hash);
+			}
+			if (m_ctrl[index] == INTERNAL::HASHMAP_CTRL_EMPTY)
+			{
+				m_growthLeft--;
+			}
+			new (bbe::addressOf(m_slots[index].entry)) Entry(std::forward<KK>(key), std::forward<arguments>(args)...);
+			//Publishes the entry before its control byte. Only needed by the optimistic readers of the ConcurrentHashMap.
+			std::atomic_thread_fence(std::memory_order_release);
+			m_ctrl[index] = getH2(hash);
+			m_length++;
+			return index;
+		}
+
+		void eraseIndex(size_t index)
+		{
+			bbe::addressOf(m_slots[index].entry)->~Entry();
+			m_length--;
+
+			//Lookups only continue past a group if it has no empty slot. If the group of the
+			//erased slot still contains an empty slot, no probe sequence can run through it and
+			//the slot may become empty again instead of leaving a tombstone behind.
+			const size_t groupStart = index - index % INTERNAL::HASHMAP_GROUP_WIDTH;
+			if (INTERNAL::HashMapGroup(m_ctrl + groupStart).matchEmpty() != 0)
+			{
+				m_ctrl[index] = INTERNAL::HASHMAP_CTRL_EMPTY;
+				m_growthLeft++;
+			}
+			else
+			{
+				m_ctrl[index] = INTERNAL::HASHMAP_CTRL_DELETED;
+			}
+		}
+
+	public:
+		explicit HashMap(Allocator* parentAllocator = nullptr)
+		{
+			initParentAllocator(parentAllocator);
+		}
+
+		HashMap(const HashMap& other) //Copy Constructor
+			: m_hasher(other.m_hasher)
+		{
+			initParentAllocator(other.m_needsToDeleteParentAllocator ? nullptr : other.m_parentAllocator);
+			reserve(other.m_length);
+			other.forEach(
+				[&](const K& key, const V& value)
+				{
+					add(key, value);
+				});
+		}
+
+		HashMap(HashMap&& other) //Move Constructor
+			: m_ctrl(other.m_ctrl), m_slots(other.m_slots), m_capacity(other.m_capacity), m_length(other.m_length), m_growthLeft(other.m_growthLeft),
+			m_hasher(std::move(other.m_hasher)), m_parentAllocator(other.m_parentAllocator), m_needsToDeleteParentAllocator(other.m_needsToDeleteParentAllocator)
+		{
+			other.m_ctrl = nullptr;
+			other.m_slots = nullptr;
+			other.m_capacity = 0;
+			other.m_length = 0;
+			other.m_growthLeft = 0;
+			other.m_parentAllocator = nullptr;
+			other.m_needsToDeleteParentAllocator = false;
+		}
+
+		HashMap& operator=(const HashMap& other) //Copy Assignment
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+			clear();
+			reserve(other.m_length);
+			other.forEach(
+				[&](const K& key, const V& value)
+				{
+					add(key, value);
+				});
+			return *this;
+		}
+
+		HashMap& operator=(HashMap&& other) //Move Assignment
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+			destroyAll();
+			deallocate();
+			if (m_needsToDeleteParentAllocator)
+			{
+				delete m_parentAllocator;
+			}
+
+			m_ctrl = other.m_ctrl;
+			m_slots = other.m_slots;
+			m_capacity = other.m_capacity;
+			m_length = other.m_length;
+			m_growthLeft = other.m_growthLeft;
+			m_hasher = std::move(other.m_hasher);
+			m_parentAllocator = other.m_parentAllocator;
+			m_needsToDeleteParentAllocator = other.m_needsToDeleteParentAllocator;
+
+			other.m_ctrl = nullptr;
+			other.m_slots = nullptr;
+			other.m_capacity = 0;
+			other.m_length = 0;
+			other.m_growthLeft = 0;
+			other.m_parentAllocator = nullptr;
+			other.m_needsToDeleteParentAllocator = false;
+			return *this;
+		}
+
+		~HashMap()
+		{
+			if (m_ctrl != nullptr)
+			{
+				destroyAll();
+				deallocate();
+			}
+			if (m_needsToDeleteParentAllocator)
+			{
+				delete m_parentAllocator;
+			}
+			m_parentAllocator = nullptr;
+		}
+
+		bool add(const K& key, const V& value)
+		{
+			const size_t hash = m_hasher(key);
+			const size_t index = findIndex(key, hash);
+			if (index != m_capacity)
+			{
+				m_slots[index].entry.value = value;
+				return false;
+			}
+			insertNew(hash, key, value);
+			return true;
+		}
+
+		bool add(K&& key, V&& value)
+		{
+			const size_t hash = m_hasher(key);
+			const size_t index = findIndex(key, hash);
+			if (index != m_capacity)
+			{
+				m_slots[index].entry.value = std::move(value);
+				return false;
+			}
+			insertNew(hash, std::move(key), std::move(value));
+			return true;
+		}
+
+		V& operator[](const K& key)
+		{
+			const size_t hash = m_hasher(key);
+			size_t index = findIndex(key, hash);
+			if (index == m_capacity)
+			{
+				index = insertNew(hash, key);
+			}
+			return m_slots[index].entry.value;
+		}
+
+		V* find(const K& key)
+		{
+			const size_t index = findIndex(key, m_hasher(key));
+			if (index == m_capacity)
+			{
+				return nullptr;
+			}
+			return bbe::addressOf(m_slots[index].entry.value);
+		}
+
+		const V* find(const K& key) const
+		{
+			const size_t index = findIndex(key, m_hasher(key));
+			if (index == m_capacity)
+			{
+				return nullptr;
+			}
+			return bbe::addressOf(m_slots[index].entry.value);
+		}
+
+		bool contains(const K& key) const
+		{
+			return findIndex(key, m_hasher(key)) != m_capacity;
+		}
+
+		bool remove(const K& key)
+		{
+			const size_t index = findIndex(key, m_hasher(key));
+			if (index == m_capacity)
+			{
+				return false;
+			}
+			eraseIndex(index);
+			return true;
+		}
+
+		void clear()
+		{
+			if (m_ctrl != nullptr)
+			{
+				destroyAll();
+			}
+		}
+
+		void reserve(size_t amountOfObjects)
+		{
+			size_t newCapacity = nextPowerOfTwo(amountOfObjects + amountOfObjects / 7 + 1);
+			if (newCapacity < INTERNAL::HASHMAP_GROUP_WIDTH)
+			{
+				newCapacity = INTERNAL::HASHMAP_GROUP_WIDTH;
+			}
+			if (newCapacity > m_capacity)
+			{
+				rehash(newCapacity);
+			}
+		}
+
+		template <typename Func>
+		void forEach(Func func)
+		{
+			for (size_t i = 0; i < m_capacity; i++)
+			{
+				if (m_ctrl[i] >= 0)
+				{
+					func(static_cast<const K&>(m_slots[i].entry.key), m_slots[i].entry.value);
+				}
+			}
+		}
+
+		template <typename Func>
+		void forEach(Func func) const
+		{
+			for (size_t i = 0; i < m_capacity; i++)
+			{
+				if (m_ctrl[i] >= 0)
+				{
+					func(static_cast<const K&>(m_slots[i].entry.key), static_cast<const V&>(m_slots[i].entry.value));
+				}
+			}
+		}
+
+		size_t getLength() const
+		{
+			return m_length;
+		}
+
+		size_t getCapacity() const
+		{
+			return m_capacity;
+		}
+
+		size_t getGrowthLeft() const
+		{
+			return m_growthLeft;
+		}
+
+		bool isEmpty() const
+		{
+			return m_length == 0;
+		}
+	};
+}
\ No newline at end of file
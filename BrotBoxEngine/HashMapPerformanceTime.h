@@ -0,0 +1,104 @@
+#pragma once
+
+#include "HashMap.h"
+#include <iostream>
+#include <unordered_map>
+#include "CPUWatch.h"
+
+namespace bbe
+{
+	namespace test
+	{
+		void hashMapPrintSpeed()
+		{
+			constexpr size_t amountOfKeys = 1000000;
+
+			double totalTimeInsertBBE = 0;
+			double totalTimeHitBBE = 0;
+			double totalTimeMissBBE = 0;
+			double totalTimeEraseBBE = 0;
+			double totalTimeInsertSTL = 0;
+			double totalTimeHitSTL = 0;
+			double totalTimeMissSTL = 0;
+			double totalTimeEraseSTL = 0;
+			int runs = 0;
+			size_t checkSum = 0;
+
+			while (true)
+			{
+				{
+					HashMap<size_t, size_t> map;
+
+					CPUWatch swInsert;
+					for (size_t i = 0; i < amountOfKeys; i++)
+					{
+						map.add(i * 7919, i);
+					}
+					totalTimeInsertBBE += swInsert.getTimeExpiredSeconds();
+
+					CPUWatch swHit;
+					for (size_t i = 0; i < amountOfKeys; i++)
+					{
+						checkSum += *map.find(i * 7919);
+					}
+					totalTimeHitBBE += swHit.getTimeExpiredSeconds();
+
+					CPUWatch swMiss;
+					for (size_t i = 0; i < amountOfKeys; i++)
+					{
+						checkSum += map.find(i * 7919 + 1) == nullptr;
+					}
+					totalTimeMissBBE += swMiss.getTimeExpiredSeconds();
+
+					CPUWatch swErase;
+					for (size_t i = 0; i < amountOfKeys; i++)
+					{
+						map.remove(i * 7919);
+					}
+					totalTimeEraseBBE += swErase.getTimeExpiredSeconds();
+				}
+
+				{
+					std::unordered_map<size_t, size_t> map;
+
+					CPUWatch swInsert;
+					for (size_t i = 0; i < amountOfKeys; i++)
+					{
+						map[i * 7919] = i;
+					}
+					totalTimeInsertSTL += swInsert.getTimeExpiredSeconds();
+
+					CPUWatch swHit;
+					for (size_t i = 0; i < amountOfKeys; i++)
+					{
+						checkSum += map.find(i * 7919)->second;
+					}
+					totalTimeHitSTL += swHit.getTimeExpiredSeconds();
+
+					CPUWatch swMiss;
+					for (size_t i = 0; i < amountOfKeys; i++)
+					{
+						checkSum += map.find(i * 7919 + 1) == map.end();
+					}
+					totalTimeMissSTL += swMiss.getTimeExpiredSeconds();
+
+					CPUWatch swErase;
+					for (size_t i = 0; i < amountOfKeys; i++)
+					{
+						map.erase(i * 7919);
+					}
+					totalTimeEraseSTL += swErase.getTimeExpiredSeconds();
+				}
+
+				runs++;
+				std::cout << "                 bbe::HashMap  std::unordered_map" << std::endl;
+				std::cout << "avg Insert Time: " << (totalTimeInsertBBE / runs) << "  " << (totalTimeInsertSTL / runs) << std::endl;
+				std::cout << "avg Hit Time:    " << (totalTimeHitBBE / runs) << "  " << (totalTimeHitSTL / runs) << std::endl;
+				std::cout << "avg Miss Time:   " << (totalTimeMissBBE / runs) << "  " << (totalTimeMissSTL / runs) << std::endl;
+				std::cout << "avg Erase Time:  " << (totalTimeEraseBBE / runs) << "  " << (totalTimeEraseSTL / runs) << std::endl;
+				std::cout << "(" << checkSum << ")" << std::endl;
+				std::cout << std::endl;
+			}
+		}
+	}
+}
\ No newline at end of file
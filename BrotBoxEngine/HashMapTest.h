@@ -0,0 +1,100 @@
+#pragma once
+
+#include "HashMap.h"
+#include "String.h"
+#include "UtilTest.h"
+
+namespace bbe
+{
+	namespace test
+	{
+		void testHashMap()
+		{
+			{
+				HashMap<int, int> map;
+				assertEquals(map.getLength(), 0);
+				assertEquals(map.getCapacity(), 0);
+				assertEquals(map.isEmpty(), true);
+				assertEquals(map.find(5), nullptr);
+				assertEquals(map.contains(5), false);
+				assertEquals(map.remove(5), false);
+
+				for (int i = 0; i < 10000; i++)
+				{
+					assertEquals(map.add(i, i * 2), true);
+				}
+				assertEquals(map.getLength(), 10000);
+				assertEquals(map.add(17, 18), false);
+				assertEquals(*map.find(17), 18);
+				map[17] = 34;
+
+				for (int i = 0; i < 10000; i++)
+				{
+					assertEquals(*map.find(i), i * 2);
+				}
+				for (int i = 10000; i < 20000; i++)
+				{
+					assertEquals(map.find(i), nullptr);
+				}
+
+				for (int i = 0; i < 10000; i += 2)
+				{
+					assertEquals(map.remove(i), true);
+				}
+				assertEquals(map.getLength(), 5000);
+				for (int i = 0; i < 10000; i++)
+				{
+					assertEquals(map.contains(i), i % 2 == 1);
+				}
+
+				//Lots of insertions and removals must not clog the map with tombstones.
+				size_t capacity = map.getCapacity();
+				for (int i = 0; i < 100000; i++)
+				{
+					map.add(20000 + i, i);
+					map.remove(20000 + i);
+				}
+				assertEquals(map.getCapacity(), capacity);
+				assertEquals(map.getLength(), 5000);
+
+				size_t amount = 0;
+				map.forEach(
+					[&](const int& key, int& value)
+					{
+						assertEquals(key % 2, 1);
+						assertEquals(value, key * 2);
+						amount++;
+					});
+				assertEquals(amount, 5000);
+
+				map.clear();
+				assertEquals(map.getLength(), 0);
+				assertEquals(map.contains(1), false);
+			}
+
+			{
+				HashMap<String, Person> map;
+				map.add("Hugo", Person("Hugo", "AStr", 1));
+				map.add("Ebert", Person("Ebert", "BStr", 2));
+				map["Lel"].age = 3;
+				assertEquals(map.getLength(), 3);
+				assertEquals(map.find("Hugo")->adress, "AStr");
+				assertEquals(map.find("Ebert")->age, 2);
+				assertEquals(map.find("Lel")->age, 3);
+				assertEquals(map.find("Okay"), nullptr);
+
+				HashMap<String, Person> copy(map);
+				assertEquals(map.remove("Hugo"), true);
+				assertEquals(map.contains("Hugo"), false);
+				assertEquals(copy.contains("Hugo"), true);
+
+				HashMap<String, Person> moved(std::move(copy));
+				assertEquals(copy.getLength(), 0);
+				assertEquals(moved.getLength(), 3);
+				assertEquals(moved.find("Hugo")->name, "Hugo");
+			}
+
+			Person::checkIfAllPersonsWereDestroyed();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "DynamicArray.h"
+#include "Hash.h"
+#include "HashMap.h"
+#include "List.h"
+#include "String.h"
+#include "StringView.h"
+#include "UtilHash.h"
+#include "UtilTest.h"
+
+namespace bbe
+{
+	namespace test
+	{
+		void testHash()
+		{
+			{
+				//Every length takes another path through hashBytes, all of them have to see every byte.
+				unsigned char data[200];
+				for (size_t i = 0; i < 200; i++)
+				{
+					data[i] = (unsigned char)(i * 37 + 11);
+				}
+				HashMap<uint64_t, size_t> seen;
+				for (size_t length = 0; length <= 200; length++)
+				{
+					const uint64_t hash = hashBytes(data, length);
+					assertEquals(hashBytes(data, length), hash);
+					assertEquals(seen.add(hash, length), true);
+					if (length > 0)
+					{
+						for (size_t i = 0; i < length; i += 7)
+						{
+							data[i] ^= 1;
+							assertUnequals(hashBytes(data, length), hash);
+							data[i] ^= 1;
+						}
+						data[length - 1] ^= 0x80;
+						assertUnequals(hashBytes(data, length), hash);
+						data[length - 1] ^= 0x80;
+					}
+				}
+				assertUnequals(hashBytes(data, 100, 1), hashBytes(data, 100, 2));
+				assertUnequals(hashCombine(1, 2), hashCombine(2, 1));
+			}
+
+			{
+				Hash<String> hashString;
+				Hash<StringView> hashView;
+				String text("Hash me please");
+				const size_t hash = hashString(text);
+				assertEquals(hash, hashView(StringView(L"Hash me please")));
+				assertEquals(hashString(String("Hash me please")), hash);
+				assertUnequals(hashString(String("Hash me pleas")), hash);
+				assertEquals(hashString(String()), hashView(StringView()));
+
+				//The cached hash has to follow every modification.
+				String copy = text;
+				assertEquals(hashString(copy), hash);
+				copy += "!";
+				assertEquals(hashString(copy), hashView(StringView(L"Hash me please!")));
+				copy[0] = L'C';
+				assertEquals(hashString(copy), hashView(StringView(L"Cash me please!")));
+				copy.toUpperCase();
+				assertEquals(hashString(copy), hashView(StringView(L"CASH ME PLEASE!")));
+				String padded("  padded  ");
+				hashString(padded);
+				padded.trim();
+				assertEquals(hashString(padded), hashView(StringView(L"padded")));
+				String moved(std::move(copy));
+				assertEquals(hashString(moved), hashView(StringView(L"CASH ME PLEASE!")));
+				moved = text;
+				assertEquals(hashString(moved), hash);
+				String adopted("Something that does not fit into SSO");
+				hashString(adopted);
+				adopted.adopt(String("Short").release());
+				assertEquals(hashString(adopted), hashView(StringView(L"Short")));
+			}
+
+			{
+				List<int> a;
+				a.pushBackAll(1, 2, 3);
+				List<int> b;
+				b.pushBackAll(1, 2, 3);
+				List<int> reversed;
+				reversed.pushBackAll(3, 2, 1);
+				Hash<List<int>> hashList;
+				assertEquals(hashList(a), hashList(b));
+				assertUnequals(hashList(a), hashList(reversed));
+				assertEquals(Hash<DynamicArray<int>>()(DynamicArray<int>(a)), hashList(a));
+
+				List<String> names;
+				names.pushBack(String("a"));
+				names.pushBack(String("bc"));
+				List<String> otherNames;
+				otherNames.pushBack(String("ab"));
+				otherNames.pushBack(String("c"));
+				Hash<List<String>> hashNames;
+				assertEquals(hashNames(names), hashNames(List<String>(names)));
+				assertUnequals(hashNames(names), hashNames(otherNames));
+				assertUnequals(hashNames(List<String>()), hashNames(names));
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,401 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <utility>
+#include "GenerationalHandle.h"
+#include "List.h"
+#include "UtilDebug.h"
+
+namespace bbe
+{
+	namespace INTERNAL
+	{
+		static constexpr size_t HEAP_NO_POSITION = std::numeric_limits<size_t>::max();
+
+		class HeapNoMoveCallback
+		{
+		public:
+			void operator()(size_t) const
+			{
+				//do nothing
+			}
+		};
+
+		template <typename T, typename Compare, size_t ARITY, typename OnMove>
+		void heapSiftUp(List<T>& data, size_t position, const Compare& compare, OnMove onMove)
+		{
+			//Moves the hole upwards instead of swapping, so every step is a single move.
+			T value = std::move(data[position]);
+			while (position > 0)
+			{
+				const size_t parent = (position - 1) / ARITY;
+				if (!compare(value, data[parent]))
+				{
+					break;
+				}
+				data[position] = std::move(data[parent]);
+				onMove(position);
+				position = parent;
+			}
+			data[position] = std::move(value);
+			onMove(position);
+		}
+
+		template <typename T, typename Compare, size_t ARITY, typename OnMove>
+		void heapSiftDown(List<T>& data, size_t position, const Compare& compare, OnMove onMove)
+		{
+			const size_t length = data.getLength();
+			T value = std::move(data[position]);
+			while (true)
+			{
+				const size_t firstChild = position * ARITY + 1;
+				if (firstChild >= length)
+				{
+					break;
+				}
+				const size_t lastChild = firstChild + ARITY < length ? firstChild + ARITY : length;
+				size_t bestChild = firstChild;
+				for (size_t child = firstChild + 1; child < lastChild; child++)
+				{
+					if (compare(data[child], data[bestChild]))
+					{
+						bestChild = child;
+					}
+				}
+				if (!compare(data[bestChild], value))
+				{
+					break;
+				}
+				data[position] = std::move(data[bestChild]);
+				onMove(position);
+				position = bestChild;
+			}
+			data[position] = std::move(value);
+			onMove(position);
+		}
+	}
+
+	template <typename T, typename Compare = std::less<T>, size_t ARITY = 4>
+	class Heap
+	{
+		//d-ary heap stored in a List. top() is the element that comes first according to Compare, so
+		//with the default std::less it is the smallest element (unlike std::priority_queue). Four
+		//children per node make the tree half as deep as a binary heap, and the children of a node
+		//usually share one cache line.
+		static_assert(ARITY >= 2, "A heap needs at least two children per node!");
+	private:
+		List<T> m_data;
+		Compare m_compare;
+
+	public:
+		explicit Heap(const Compare& compare = Compare())
+			: m_compare(compare)
+		{
+			//do nothing
+		}
+
+		void push(const T& value)
+		{
+			m_data.pushBack(value);
+			INTERNAL::heapSiftUp<T, Compare, ARITY>(m_data, m_data.getLength() - 1, m_compare, INTERNAL::HeapNoMoveCallback());
+		}
+
+		void push(T&& value)
+		{
+			m_data.pushBack(std::move(value));
+			INTERNAL::heapSiftUp<T, Compare, ARITY>(m_data, m_data.getLength() - 1, m_compare, INTERNAL::HeapNoMoveCallback());
+		}
+
+		const T& top() const
+		{
+			if (m_data.isEmpty())
+			{
+				debugBreak();
+			}
+			return m_data[0];
+		}
+
+		T popTop()
+		{
+			if (m_data.isEmpty())
+			{
+				debugBreak();
+			}
+			T retVal = std::move(m_data[0]);
+			if (m_data.getLength() > 1)
+			{
+				m_data[0] = std::move(m_data.last());
+				m_data.popBack();
+				INTERNAL::heapSiftDown<T, Compare, ARITY>(m_data, 0, m_compare, INTERNAL::HeapNoMoveCallback());
+			}
+			else
+			{
+				m_data.popBack();
+			}
+			return retVal;
+		}
+
+		void clear()
+		{
+			m_data.clear();
+		}
+
+		void resizeCapacity(size_t newCapacity)
+		{
+			m_data.resizeCapacity(newCapacity);
+		}
+
+		size_t getLength() const
+		{
+			return m_data.getLength();
+		}
+
+		bool isEmpty() const
+		{
+			return m_data.isEmpty();
+		}
+	};
+
+	typedef GenerationalHandle IndexedHeapHandle;
+
+	namespace INTERNAL
+	{
+		template <typename T>
+		class IndexedHeapEntry
+		{
+		public:
+			T m_value;
+			uint32_t m_slot;
+
+			IndexedHeapEntry(T&& value, uint32_t slot)
+				: m_value(std::move(value)), m_slot(slot)
+			{
+				//do nothing
+			}
+		};
+
+		class IndexedHeapSlot
+		{
+		public:
+			size_t m_position;
+			//Incremented on every removal, so that old handles to this slot become invalid.
+			uint32_t m_generation;
+
+			IndexedHeapSlot(size_t position, uint32_t generation)
+				: m_position(position), m_generation(generation)
+			{
+				//do nothing
+			}
+		};
+
+		template <typename T, typename Compare>
+		class IndexedHeapCompare
+		{
+		public:
+			const Compare* m_compare;
+
+			bool operator()(const IndexedHeapEntry<T>& a, const IndexedHeapEntry<T>& b) const
+			{
+				return (*m_compare)(a.m_value, b.m_value);
+			}
+		};
+	}
+
+	template <typename T, typename Compare = std::less<T>, size_t ARITY = 4>
+	class IndexedHeap
+	{
+		//Heap whose elements can be changed or removed after they were pushed. push returns a handle
+		//that stays valid until the element is popped or removed. Like the SlotMap, handles point to
+		//slots that are reused, and a generation tells old handles to a reused slot apart. The slots
+		//store the heap position of their element and are updated on every move.
+		static_assert(ARITY >= 2, "A heap needs at least two children per node!");
+	private:
+		typedef INTERNAL::IndexedHeapEntry<T> Entry;
+		typedef INTERNAL::IndexedHeapCompare<T, Compare> EntryCompare;
+
+		List<Entry> m_data;
+		List<INTERNAL::IndexedHeapSlot> m_slots;
+		List<uint32_t> m_freeSlots;
+		Compare m_compare;
+
+		class PositionUpdater
+		{
+		public:
+			IndexedHeap* m_heap;
+
+			void operator()(size_t position) const
+			{
+				m_heap->m_slots[m_heap->m_data[position].m_slot].m_position = position;
+			}
+		};
+
+		EntryCompare getEntryCompare() const
+		{
+			EntryCompare entryCompare;
+			entryCompare.m_compare = &m_compare;
+			return entryCompare;
+		}
+
+		PositionUpdater getPositionUpdater()
+		{
+			PositionUpdater updater;
+			updater.m_heap = this;
+			return updater;
+		}
+
+		size_t getPosition(const IndexedHeapHandle& handle) const
+		{
+			if (!contains(handle))
+			{
+				debugBreak();
+			}
+			return m_slots[handle.m_index].m_position;
+		}
+
+		IndexedHeapHandle getHandle(uint32_t slot) const
+		{
+			return IndexedHeapHandle(slot, m_slots[slot].m_generation);
+		}
+
+		void restoreHeapAt(size_t position)
+		{
+			if (position > 0 && m_compare(m_data[position].m_value, m_data[(position - 1) / ARITY].m_value))
+			{
+				INTERNAL::heapSiftUp<Entry, EntryCompare, ARITY>(m_data, position, getEntryCompare(), getPositionUpdater());
+			}
+			else
+			{
+				INTERNAL::heapSiftDown<Entry, EntryCompare, ARITY>(m_data, position, getEntryCompare(), getPositionUpdater());
+			}
+		}
+
+	public:
+		explicit IndexedHeap(const Compare& compare = Compare())
+			: m_compare(compare)
+		{
+			//do nothing
+		}
+
+		IndexedHeapHandle push(T value)
+		{
+			uint32_t slot;
+			if (m_freeSlots.isEmpty())
+			{
+				slot = (uint32_t)m_slots.getLength();
+				m_slots.pushBack(INTERNAL::IndexedHeapSlot(INTERNAL::HEAP_NO_POSITION, 0));
+			}
+			else
+			{
+				slot = m_freeSlots.last();
+				m_freeSlots.popBack();
+			}
+			m_data.pushBack(Entry(std::move(value), slot));
+			INTERNAL::heapSiftUp<Entry, EntryCompare, ARITY>(m_data, m_data.getLength() - 1, getEntryCompare(), getPositionUpdater());
+			return getHandle(slot);
+		}
+
+		bool contains(const IndexedHeapHandle& handle) const
+		{
+			return handle.m_index < m_slots.getLength() && m_slots[handle.m_index].m_generation == handle.m_generation;
+		}
+
+		const T& get(const IndexedHeapHandle& handle) const
+		{
+			return m_data[getPosition(handle)].m_value;
+		}
+
+		void decreaseKey(const IndexedHeapHandle& handle, T value)
+		{
+			//value must not come later than the old value according to Compare. O(log n)
+			const size_t position = getPosition(handle);
+			if (m_compare(m_data[position].m_value, value))
+			{
+				debugBreak();
+			}
+			m_data[position].m_value = std::move(value);
+			INTERNAL::heapSiftUp<Entry, EntryCompare, ARITY>(m_data, position, getEntryCompare(), getPositionUpdater());
+		}
+
+		void update(const IndexedHeapHandle& handle, T value)
+		{
+			//Like decreaseKey, but value may also come later than the old value.
+			const size_t position = getPosition(handle);
+			m_data[position].m_value = std::move(value);
+			restoreHeapAt(position);
+		}
+
+		void remove(const IndexedHeapHandle& handle)
+		{
+			const size_t position = getPosition(handle);
+			INTERNAL::IndexedHeapSlot& slot = m_slots[handle.m_index];
+			slot.m_position = INTERNAL::HEAP_NO_POSITION;
+			slot.m_generation++;
+			m_freeSlots.pushBack(handle.m_index);
+			if (position != m_data.getLength() - 1)
+			{
+				m_data[position] = std::move(m_data.last());
+				m_data.popBack();
+				m_slots[m_data[position].m_slot].m_position = position;
+				restoreHeapAt(position);
+			}
+			else
+			{
+				m_data.popBack();
+			}
+		}
+
+		const T& top() const
+		{
+			if (m_data.isEmpty())
+			{
+				debugBreak();
+			}
+			return m_data[0].m_value;
+		}
+
+		IndexedHeapHandle topHandle() const
+		{
+			if (m_data.isEmpty())
+			{
+				debugBreak();
+			}
+			return getHandle(m_data[0].m_slot);
+		}
+
+		T popTop()
+		{
+			if (m_data.isEmpty())
+			{
+				debugBreak();
+			}
+			T retVal = std::move(m_data[0].m_value);
+			remove(getHandle(m_data[0].m_slot));
+			return retVal;
+		}
+
+		void clear()
+		{
+			//The slots are kept, so that the handles to the cleared elements stay invalid.
+			for (size_t i = 0; i < m_data.getLength(); i++)
+			{
+				INTERNAL::IndexedHeapSlot& slot = m_slots[m_data[i].m_slot];
+				slot.m_position = INTERNAL::HEAP_NO_POSITION;
+				slot.m_generation++;
+				m_freeSlots.pushBack(m_data[i].m_slot);
+			}
+			m_data.clear();
+		}
+
+		size_t getLength() const
+		{
+			return m_data.getLength();
+		}
+
+		bool isEmpty() const
+		{
+			return m_data.isEmpty();
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Heap.h"
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <vector>
+#include "CPUWatch.h"
+
+namespace bbe
+{
+	namespace test
+	{
+		void heapPrintSpeed()
+		{
+			double totalTimeHeap = 0;
+			double totalTimeBinaryHeap = 0;
+			double totalTimeSTL = 0;
+			int runs = 0;
+
+			while (true)
+			{
+				constexpr size_t amountOfValues = 2000000;
+				List<uint32_t> values;
+				uint32_t random = 12345;
+				for (size_t i = 0; i < amountOfValues; i++)
+				{
+					random = random * 1664525 + 1013904223;
+					values.pushBack(random);
+				}
+
+				uint32_t checksum = 0;
+
+				CPUWatch swHeap;
+				Heap<uint32_t> heap;
+				for (size_t i = 0; i < amountOfValues; i++)
+				{
+					heap.push(values[i]);
+				}
+				while (!heap.isEmpty())
+				{
+					checksum += heap.popTop();
+				}
+				totalTimeHeap += swHeap.getTimeExpiredSeconds();
+
+				CPUWatch swBinaryHeap;
+				Heap<uint32_t, std::less<uint32_t>, 2> binaryHeap;
+				for (size_t i = 0; i < amountOfValues; i++)
+				{
+					binaryHeap.push(values[i]);
+				}
+				while (!binaryHeap.isEmpty())
+				{
+					checksum -= binaryHeap.popTop();
+				}
+				totalTimeBinaryHeap += swBinaryHeap.getTimeExpiredSeconds();
+
+				CPUWatch swSTL;
+				std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>> stlHeap;
+				for (size_t i = 0; i < amountOfValues; i++)
+				{
+					stlHeap.push(values[i]);
+				}
+				while (!stlHeap.empty())
+				{
+					checksum += stlHeap.top();
+					stlHeap.pop();
+				}
+				totalTimeSTL += swSTL.getTimeExpiredSeconds();
+
+				runs++;
+				std::cout << "checksum: " << checksum << std::endl;
+				std::cout << "avg Heap (4-ary):       " << (totalTimeHeap / runs) << std::endl;
+				std::cout << "avg Heap (2-ary):       " << (totalTimeBinaryHeap / runs) << std::endl;
+				std::cout << "avg std::priority_queue: " << (totalTimeSTL / runs) << std::endl;
+				std::cout << std::endl;
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "Heap.h"
+#include "List.h"
+#include "UtilTest.h"
+#include <functional>
+
+namespace bbe
+{
+	namespace test
+	{
+		void testHeap()
+		{
+			{
+				Heap<int> heap;
+				assertEquals(heap.getLength(), 0);
+				assertEquals(heap.isEmpty(), true);
+
+				uint32_t random = 12345;
+				List<int> values;
+				for (int i = 0; i < 1000; i++)
+				{
+					random = random * 1664525 + 1013904223;
+					values.pushBack((int)(random >> 20));
+					heap.push(values.last());
+				}
+				assertEquals(heap.getLength(), 1000);
+				values.sort();
+				for (size_t i = 0; i < values.getLength(); i++)
+				{
+					assertEquals(heap.top(), values[i]);
+					assertEquals(heap.popTop(), values[i]);
+				}
+				assertEquals(heap.isEmpty(), true);
+			}
+
+			{
+				Heap<Person, std::greater<Person>, 2> heap;
+				heap.push(Person("Name 1", "Addr 1", 10));
+				heap.push(Person("Name 2", "Addr 2", 30));
+				heap.push(Person("Name 3", "Addr 3", 20));
+				assertEquals(heap.top().age, 30);
+				assertEquals(heap.popTop().name, "Name 2");
+				assertEquals(heap.popTop().name, "Name 3");
+				assertEquals(heap.getLength(), 1);
+				heap.clear();
+				assertEquals(heap.isEmpty(), true);
+			}
+
+			Person::checkIfAllPersonsWereDestroyed();
+
+			{
+				IndexedHeap<int> heap;
+				IndexedHeapHandle h50 = heap.push(50);
+				IndexedHeapHandle h40 = heap.push(40);
+				IndexedHeapHandle h30 = heap.push(30);
+				IndexedHeapHandle h20 = heap.push(20);
+				IndexedHeapHandle h10 = heap.push(10);
+				IndexedHeapHandle h60 = heap.push(60);
+				assertEquals(heap.getLength(), 6);
+				assertEquals(heap.top(), 10);
+				assertEquals(heap.topHandle(), h10);
+				assertEquals(heap.get(h40), 40);
+
+				heap.decreaseKey(h60, 5);
+				assertEquals(heap.topHandle(), h60);
+				assertEquals(heap.get(h60), 5);
+
+				heap.update(h60, 100);
+				assertEquals(heap.topHandle(), h10);
+
+				heap.remove(h20);
+				assertEquals(heap.contains(h20), false);
+				assertEquals(heap.getLength(), 5);
+
+				assertEquals(heap.popTop(), 10);
+				assertEquals(heap.contains(h10), false);
+				assertEquals(heap.popTop(), 30);
+				assertEquals(heap.popTop(), 40);
+				assertEquals(heap.contains(h30), false);
+				assertEquals(heap.contains(h40), false);
+
+				//Freed slots are reused, but the old handles to them stay invalid.
+				IndexedHeapHandle h = heap.push(1);
+				assertEquals(heap.contains(h), true);
+				assertEquals(h.m_index, h40.m_index);
+				assertUnequals(h, h40);
+				assertEquals(heap.contains(h40), false);
+				assertEquals(heap.top(), 1);
+				assertEquals(heap.popTop(), 1);
+				assertEquals(heap.popTop(), 50);
+				assertEquals(heap.get(h60), 100);
+				assertEquals(heap.popTop(), 100);
+				assertEquals(heap.isEmpty(), true);
+				assertEquals(heap.contains(h50), false);
+			}
+
+			{
+				IndexedHeap<int> heap;
+				IndexedHeapHandle first = heap.push(1);
+				heap.push(2);
+				assertEquals(heap.contains(IndexedHeapHandle()), false);
+				heap.clear();
+				assertEquals(heap.contains(first), false);
+				IndexedHeapHandle reused = heap.push(3);
+				assertEquals(heap.contains(reused), true);
+				assertEquals(heap.contains(first), false);
+				assertEquals(heap.getLength(), 1);
+				assertEquals(heap.popTop(), 3);
+			}
+
+			{
+				//Dijkstra like usage: many decreaseKeys, the pop order must match the final keys.
+				IndexedHeap<int> heap;
+				List<IndexedHeapHandle> handles;
+				List<int> keys;
+				for (int i = 0; i < 500; i++)
+				{
+					handles.pushBack(heap.push(1000 + i));
+					keys.pushBack(1000 + i);
+				}
+				uint32_t random = 1;
+				for (int i = 0; i < 2000; i++)
+				{
+					random = random * 1664525 + 1013904223;
+					const size_t index = (random >> 8) % 500;
+					const int newKey = keys[index] - (int)((random >> 20) % 10);
+					heap.decreaseKey(handles[index], newKey);
+					keys[index] = newKey;
+				}
+				keys.sort();
+				for (size_t i = 0; i < keys.getLength(); i++)
+				{
+					assertEquals(heap.popTop(), keys[i]);
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
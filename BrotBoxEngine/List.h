@@ -4,25 +4,11 @@
 #include "STLCapsule.h"
 #include "Array.h"
 #include "DynamicArray.h"
+#include "ListChunk.h"
 #include <initializer_list>
 
 namespace bbe
 {
-	namespace INTERNAL
-	{
-		template <typename T>
-		union ListChunk
-		{
-			//this little hack prevents the constructor of T to be called
-			//allows the use of new and its auto alignment features
-			T value;
-
-			ListChunk() {}
-			~ListChunk() {}
-		};
-	}
-	
-
 	template <typename T, bool keepSorted = false>
 	class List
 	{
@@ -60,6 +46,19 @@ namespace bbe
 			}
 		}
 
+		template <bool dummyKeepSorted = keepSorted>
+		typename std::enable_if<!dummyKeepSorted, void>::type sortAdopted()
+		{
+			//do nothing
+		}
+
+		template <bool dummyKeepSorted = keepSorted>
+		typename std::enable_if<dummyKeepSorted, void>::type sortAdopted()
+		{
+			static_assert(dummyKeepSorted == keepSorted, "Do not specify dummyKeepSorted!");
+			sort();
+		}
+
 	public:
 		List()
 			: m_length(0), m_capacity(0), m_data(nullptr)
@@ -96,6 +95,12 @@ namespace bbe
 			other.m_capacity = 0;
 		}
 
+		List(ListBuffer<T>&& buffer)
+			: m_length(0), m_capacity(0), m_data(nullptr)
+		{
+			adopt(std::move(buffer));
+		}
+
 		List(std::initializer_list<T> il) {
 			//UNTESTED
 			for (auto iter = il.begin(); iter != il.end(); iter++) {
@@ -271,14 +276,8 @@ namespace bbe
 			int insertionIndex = i;
 			for (; i >= insertionIndex - amount + 1 && i >= 0; i--)
 			{
-				if (i >= m_length)
-				{
-					new (bbe::addressOf(m_data[i])) T(val);
-				}
-				else
-				{
-					m_data[i].value = val;
-				}
+				//Slots below m_length were moved up and destroyed above, so they are constructed as well.
+				new (bbe::addressOf(m_data[i])) T(val);
 			}
 			m_length += amount;
 		}
@@ -323,20 +322,14 @@ namespace bbe
 			int insertionIndex = i;
 			for (; i >= insertionIndex - amount + 1 && i >= 0; i--)
 			{
-				if (i >= m_length)
+				//Slots below m_length were moved up and destroyed above, so they are constructed as well.
+				if (amount == 1)
 				{
-					if (amount == 1)
-					{
-						new (bbe::addressOf(m_data[m_length])) T(std::move(val));
-					}
-					else
-					{
-						new (bbe::addressOf(m_data[i])) T(val);
-					}
+					new (bbe::addressOf(m_data[i])) T(std::move(val));
 				}
 				else
 				{
-					m_data[i].value = val;
+					new (bbe::addressOf(m_data[i])) T(val);
 				}
 			}
 			m_length += amount;
@@ -536,6 +529,30 @@ namespace bbe
 			m_length -= amount;
 		}
 
+		ListBuffer<T> release()
+		{
+			//Hands the buffer over without touching the elements. The List is empty afterwards.
+			ListBuffer<T> retVal(m_data, m_length, m_capacity);
+			m_data = nullptr;
+			m_length = 0;
+			m_capacity = 0;
+			return retVal;
+		}
+
+		void adopt(ListBuffer<T>&& buffer)
+		{
+			//Takes over the buffer in O(1). A List with keepSorted sorts the adopted elements.
+			clear();
+			if (m_data != nullptr)
+			{
+				delete[] m_data;
+			}
+			m_length = buffer.getLength();
+			m_capacity = buffer.getCapacity();
+			m_data = buffer.takeData();
+			sortAdopted();
+		}
+
 		void clear()
 		{
 			for (size_t i = 0; i < m_length; i++)
@@ -606,6 +623,7 @@ namespace bbe
 				delete[] m_data;
 			}
 			m_data = newList;
+			m_capacity = newCapacity;
 		}
 
 		size_t removeAll(const T& remover)
@@ -738,6 +756,16 @@ namespace bbe
 			sortSTL(reinterpret_cast<T*>(m_data), reinterpret_cast<T*>(m_data + m_length), predicate);
 		}
 
+		void sortParallel(size_t sequentialThreshold = SORT_PARALLEL_DEFAULT_THRESHOLD)
+		{
+			sortParallelSTL(reinterpret_cast<T*>(m_data), reinterpret_cast<T*>(m_data + m_length), std::less<T>(), sequentialThreshold);
+		}
+
+		void sortParallel(std::function<bool(const T&, const T&)> predicate, size_t sequentialThreshold = SORT_PARALLEL_DEFAULT_THRESHOLD)
+		{
+			sortParallelSTL(reinterpret_cast<T*>(m_data), reinterpret_cast<T*>(m_data + m_length), predicate, sequentialThreshold);
+		}
+
 		T& first()
 		{
 			//UNTESTED
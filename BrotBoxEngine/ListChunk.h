@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstddef>
+
+namespace bbe
+{
+	template <typename T, bool keepSorted>
+	class List;
+
+	template <typename T>
+	class DynamicArray;
+
+	class String;
+
+	class StringBuilder;
+
+	namespace INTERNAL
+	{
+		template <typename T>
+		union ListChunk
+		{
+			//this little hack prevents the constructor of T to be called
+			//allows the use of new and its auto alignment features
+			T value;
+
+			ListChunk() {}
+			~ListChunk() {}
+		};
+	}
+
+	template <typename T>
+	class ListBuffer
+	{
+		//The storage of a List, DynamicArray or String while it is handed from one to another with
+		//release and adopt. The first getLength() elements are constructed, the rest of the capacity is
+		//not. A buffer that is never adopted destroys its elements itself.
+		template <typename U, bool keepSorted>
+		friend class List;
+		template <typename U>
+		friend class DynamicArray;
+		friend class String;
+		friend class StringBuilder;
+
+	private:
+		INTERNAL::ListChunk<T>* m_data;
+		size_t m_length;
+		size_t m_capacity;
+
+		ListBuffer(INTERNAL::ListChunk<T>* data, size_t length, size_t capacity)
+			: m_data(data), m_length(length), m_capacity(capacity)
+		{
+			//do nothing
+		}
+
+		INTERNAL::ListChunk<T>* takeData()
+		{
+			INTERNAL::ListChunk<T>* retVal = m_data;
+			m_data = nullptr;
+			m_length = 0;
+			m_capacity = 0;
+			return retVal;
+		}
+
+		void destroy()
+		{
+			if (m_data != nullptr)
+			{
+				for (size_t i = 0; i < m_length; i++)
+				{
+					m_data[i].value.~T();
+				}
+				delete[] m_data;
+			}
+			m_data = nullptr;
+			m_length = 0;
+			m_capacity = 0;
+		}
+
+	public:
+		ListBuffer()
+			: m_data(nullptr), m_length(0), m_capacity(0)
+		{
+			//do nothing
+		}
+
+		ListBuffer(const ListBuffer& other) = delete;
+		ListBuffer& operator=(const ListBuffer& other) = delete;
+
+		ListBuffer(ListBuffer&& other)
+			: m_data(other.m_data), m_length(other.m_length), m_capacity(other.m_capacity)
+		{
+			other.m_data = nullptr;
+			other.m_length = 0;
+			other.m_capacity = 0;
+		}
+
+		ListBuffer& operator=(ListBuffer&& other)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+			destroy();
+			m_data = other.m_data;
+			m_length = other.m_length;
+			m_capacity = other.m_capacity;
+			other.m_data = nullptr;
+			other.m_length = 0;
+			other.m_capacity = 0;
+			return *this;
+		}
+
+		~ListBuffer()
+		{
+			destroy();
+		}
+
+		size_t getLength() const
+		{
+			return m_length;
+		}
+
+		size_t getCapacity() const
+		{
+			return m_capacity;
+		}
+
+		T* getRaw()
+		{
+			return reinterpret_cast<T*>(m_data);
+		}
+
+		const T* getRaw() const
+		{
+			return reinterpret_cast<const T*>(m_data);
+		}
+	};
+}
\ No newline at end of file
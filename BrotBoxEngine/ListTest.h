@@ -1448,6 +1448,45 @@ namespace bbe
 			Person::checkIfAllPersonsWereDestroyed();
 			Person::resetTestStatistics();
 
+			{
+				List<int> sortParallelList;
+				uint32_t random = 12345;
+				for (int i = 0; i < 10000; i++)
+				{
+					random = random * 1664525 + 1013904223;
+					sortParallelList.pushBack((int)(random >> 16));
+				}
+				List<int> sortedList = sortParallelList;
+				sortedList.sort();
+
+				//A tiny threshold forces the parallel path even for a small list.
+				sortParallelList.sortParallel(16);
+				assertEquals(sortParallelList.getLength(), 10000);
+				for (size_t i = 0; i < sortParallelList.getLength(); i++)
+				{
+					assertEquals(sortParallelList[i], sortedList[i]);
+				}
+
+				sortParallelList.sortParallel([](const int& a, const int& b) { return a > b; }, 16);
+				for (size_t i = 1; i < sortParallelList.getLength(); i++)
+				{
+					assertEquals(sortParallelList[i - 1] >= sortParallelList[i], true);
+				}
+
+				DynamicArray<int> sortDynamicArray(sortParallelList);
+				sortDynamicArray.sortParallel(16);
+				for (size_t i = 0; i < sortDynamicArray.getLength(); i++)
+				{
+					assertEquals(sortDynamicArray[i], sortedList[i]);
+				}
+				sortDynamicArray.sort([](const int& a, const int& b) { return a > b; });
+				assertEquals(sortDynamicArray[0], sortedList.last());
+
+				List<int> emptyList;
+				emptyList.sortParallel(1);
+				assertEquals(emptyList.getLength(), 0);
+			}
+
 			{
 				List<Person> sortPersonList;
 				sortPersonList.pushBackAll(
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "SPSCQueue.h"
+#include "STLAllocator.h"
+#include "STLCapsule.h"
+#include "UtilMath.h"
+
+namespace bbe
+{
+	namespace INTERNAL
+	{
+		template <typename T>
+		class MPMCQueueCell
+		{
+		public:
+			std::atomic<size_t> m_sequence;
+			QueueChunk<T> m_chunk;
+		};
+	}
+
+	template <typename T, typename Allocator = STLAllocator<INTERNAL::MPMCQueueCell<T>>>
+	class MPMCQueue
+	{
+		//Bounded lock free queue for any amount of producers and consumers (Dmitry Vyukov's design).
+		//Every cell carries a sequence number that tells whether it is ready to be written or read
+		//in the current lap, so producers and consumers only have to agree on a position via CAS.
+	private:
+		static constexpr size_t MPMC_QUEUE_DEFAULT_SIZE = 1024;
+
+		alignas(INTERNAL::QUEUE_CACHE_LINE_SIZE) std::atomic<size_t> m_enqueuePos;
+		alignas(INTERNAL::QUEUE_CACHE_LINE_SIZE) std::atomic<size_t> m_dequeuePos;
+		alignas(INTERNAL::QUEUE_CACHE_LINE_SIZE) INTERNAL::MPMCQueueCell<T>* m_data = nullptr;
+		size_t m_capacity;
+		size_t m_mask;
+
+		Allocator* m_parentAllocator = nullptr;
+		bool m_needsToDeleteParentAllocator = false;
+
+		size_t claimEnqueue(size_t& maxAmount)
+		{
+			//Returns the first claimed position, maxAmount is set to the amount of claimed cells.
+			size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+			while (maxAmount > 0)
+			{
+				size_t amount = 0;
+				while (amount < maxAmount && m_data[(pos + amount) & m_mask].m_sequence.load(std::memory_order_acquire) == pos + amount)
+				{
+					amount++;
+				}
+				if (amount == 0)
+				{
+					const intptr_t diff = (intptr_t)m_data[pos & m_mask].m_sequence.load(std::memory_order_acquire) - (intptr_t)pos;
+					if (diff < 0)
+					{
+						maxAmount = 0;
+						return pos;
+					}
+					pos = m_enqueuePos.load(std::memory_order_relaxed);
+				}
+				else if (m_enqueuePos.compare_exchange_weak(pos, pos + amount, std::memory_order_relaxed))
+				{
+					maxAmount = amount;
+					return pos;
+				}
+			}
+			return pos;
+		}
+
+		size_t claimDequeue(size_t& maxAmount)
+		{
+			size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+			while (maxAmount > 0)
+			{
+				size_t amount = 0;
+				while (amount < maxAmount && m_data[(pos + amount) & m_mask].m_sequence.load(std::memory_order_acquire) == pos + amount + 1)
+				{
+					amount++;
+				}
+				if (amount == 0)
+				{
+					const intptr_t diff = (intptr_t)m_data[pos & m_mask].m_sequence.load(std::memory_order_acquire) - (intptr_t)(pos + 1);
+					if (diff < 0)
+					{
+						maxAmount = 0;
+						return pos;
+					}
+					pos = m_dequeuePos.load(std::memory_order_relaxed);
+				}
+				else if (m_dequeuePos.compare_exchange_weak(pos, pos + amount, std::memory_order_relaxed))
+				{
+					maxAmount = amount;
+					return pos;
+				}
+			}
+			return pos;
+		}
+
+		template <typename U>
+		bool pushImpl(U&& value)
+		{
+			size_t amount = 1;
+			const size_t pos = claimEnqueue(amount);
+			if (amount == 0)
+			{
+				return false;
+			}
+			INTERNAL::MPMCQueueCell<T>& cell = m_data[pos & m_mask];
+			new (bbe::addressOf(cell.m_chunk.value)) T(std::forward<U>(value));
+			cell.m_sequence.store(pos + 1, std::memory_order_release);
+			return true;
+		}
+
+	public:
+		explicit MPMCQueue(size_t size = MPMC_QUEUE_DEFAULT_SIZE, Allocator* parentAllocator = nullptr)
+			: m_enqueuePos(0), m_dequeuePos(0), m_capacity(nextPowerOfTwo(size < 2 ? 2 : size)), m_mask(nextPowerOfTwo(size < 2 ? 2 : size) - 1), m_parentAllocator(parentAllocator)
+		{
+			if (m_parentAllocator == nullptr)
+			{
+				m_parentAllocator = new Allocator();
+				m_needsToDeleteParentAllocator = true;
+			}
+			m_data = m_parentAllocator->allocate(m_capacity);
+			for (size_t i = 0; i < m_capacity; i++)
+			{
+				new (bbe::addressOf(m_data[i].m_sequence)) std::atomic<size_t>(i);
+			}
+		}
+
+		MPMCQueue(const MPMCQueue&  other) = delete; //Copy Constructor
+		MPMCQueue(MPMCQueue&& other) = delete; //Move Constructor
+		MPMCQueue& operator=(const MPMCQueue&  other) = delete; //Copy Assignment
+		MPMCQueue& operator=(MPMCQueue&& other) = delete; //Move Assignment
+
+		~MPMCQueue()
+		{
+			const size_t enqueuePos = m_enqueuePos.load(std::memory_order_relaxed);
+			for (size_t i = m_dequeuePos.load(std::memory_order_relaxed); i != enqueuePos; i++)
+			{
+				bbe::addressOf(m_data[i & m_mask].m_chunk.value)->~T();
+			}
+			if (m_data != nullptr && m_parentAllocator != nullptr)
+			{
+				m_parentAllocator->deallocate(m_data, m_capacity);
+			}
+			if (m_needsToDeleteParentAllocator)
+			{
+				delete m_parentAllocator;
+			}
+			m_data = nullptr;
+		}
+
+		bool push(const T& value)
+		{
+			return pushImpl(value);
+		}
+
+		bool push(T&& value)
+		{
+			return pushImpl(std::move(value));
+		}
+
+		size_t pushBatch(const T* values, size_t amount)
+		{
+			//Claims up to amount consecutive cells with a single CAS. Returns how many values were pushed.
+			const size_t pos = claimEnqueue(amount);
+			for (size_t i = 0; i < amount; i++)
+			{
+				INTERNAL::MPMCQueueCell<T>& cell = m_data[(pos + i) & m_mask];
+				new (bbe::addressOf(cell.m_chunk.value)) T(values[i]);
+				cell.m_sequence.store(pos + i + 1, std::memory_order_release);
+			}
+			return amount;
+		}
+
+		bool pop(T& out)
+		{
+			size_t amount = 1;
+			const size_t pos = claimDequeue(amount);
+			if (amount == 0)
+			{
+				return false;
+			}
+			INTERNAL::MPMCQueueCell<T>& cell = m_data[pos & m_mask];
+			out = std::move(cell.m_chunk.value);
+			bbe::addressOf(cell.m_chunk.value)->~T();
+			cell.m_sequence.store(pos + m_capacity, std::memory_order_release);
+			return true;
+		}
+
+		size_t popBatch(T* out, size_t maxAmount)
+		{
+			//Returns how many values were written to out.
+			const size_t pos = claimDequeue(maxAmount);
+			for (size_t i = 0; i < maxAmount; i++)
+			{
+				INTERNAL::MPMCQueueCell<T>& cell = m_data[(pos + i) & m_mask];
+				out[i] = std::move(cell.m_chunk.value);
+				bbe::addressOf(cell.m_chunk.value)->~T();
+				cell.m_sequence.store(pos + i + m_capacity, std::memory_order_release);
+			}
+			return maxAmount;
+		}
+
+		size_t getCapacity() const
+		{
+			return m_capacity;
+		}
+	};
+}
\ No newline at end of file
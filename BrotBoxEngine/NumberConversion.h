@@ -0,0 +1,880 @@
+#pragma once
+
+#include <cerrno>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include "StringView.h"
+
+namespace bbe
+{
+	//Conversion between numbers and text that neither allocates nor depends on the locale. Integers are
+	//written two digits at a time. Floating point numbers are written with digits that read back to the
+	//same value (Grisu2), in the notation of JavaScript: 2839.192, 0.001, 1e+21, 1e-7. These are usually
+	//the shortest such digits. For a small fraction of values Grisu2 emits one digit more than needed.
+	//The parse functions work like std::from_chars: they parse the longest prefix that is a number and
+	//report where it ended and whether it failed.
+
+	enum class NumberParseError
+	{
+		NONE,
+		INVALID_ARGUMENT,
+		OUT_OF_RANGE,
+	};
+
+	template <typename Char>
+	struct NumberParseResult
+	{
+		const Char* end;
+		NumberParseError error;
+	};
+
+	//Enough for every number formatted here, including the terminating 0.
+	static constexpr size_t NUMBER_FORMAT_MAX_LENGTH = 32;
+
+	namespace INTERNAL
+	{
+		static const char NUMBER_DIGIT_PAIRS[201] =
+			"00010203040506070809"
+			"10111213141516171819"
+			"20212223242526272829"
+			"30313233343536373839"
+			"40414243444546474849"
+			"50515253545556575859"
+			"60616263646566676869"
+			"70717273747576777879"
+			"80818283848586878889"
+			"90919293949596979899";
+
+		static const uint64_t NUMBER_POWERS_OF_TEN[20] = {
+			1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+			10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+			1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+		};
+
+		//10^k for k = -348, -340, ..., 340 as normalized 64 bit significand and binary exponent.
+		static const uint64_t NUMBER_CACHED_POWERS_SIGNIFICAND[87] = {
+			0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL, 0xcf42894a5dce35eaULL,
+			0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL, 0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL,
+			0xbe5691ef416bd60cULL, 0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+			0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL, 0xc21094364dfb5637ULL,
+			0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL, 0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL,
+			0xb23867fb2a35b28eULL, 0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+			0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL, 0xb5b5ada8aaff80b8ULL,
+			0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL, 0x964e858c91ba2655ULL, 0xdff9772470297ebdULL,
+			0xa6dfbd9fb8e5b88fULL, 0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+			0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL, 0xaa242499697392d3ULL,
+			0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL, 0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL,
+			0x9c40000000000000ULL, 0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+			0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL, 0x9f4f2726179a2245ULL,
+			0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL, 0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL,
+			0x924d692ca61be758ULL, 0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+			0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL, 0x952ab45cfa97a0b3ULL,
+			0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL, 0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL,
+			0x88fcf317f22241e2ULL, 0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+			0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL, 0x8bab8eefb6409c1aULL,
+			0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL, 0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL,
+			0x80444b5e7aa7cf85ULL, 0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+			0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL
+		};
+
+		static const int16_t NUMBER_CACHED_POWERS_EXPONENT[87] = {
+			-1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954,
+			-927, -901, -874, -847, -821, -794, -768, -741, -715, -688, -661,
+			-635, -608, -582, -555, -529, -502, -475, -449, -422, -396, -369,
+			-343, -316, -289, -263, -236, -210, -183, -157, -130, -103, -77,
+			-50, -24, 3, 30, 56, 83, 109, 136, 162, 189, 216,
+			242, 269, 295, 322, 348, 375, 402, 428, 455, 481, 508,
+			534, 561, 588, 614, 641, 667, 694, 720, 747, 774, 800,
+			827, 853, 880, 907, 933, 960, 986, 1013, 1039, 1066
+		};
+
+		struct DiyFp
+		{
+			//Floating point number f * 2^e with a 64 bit significand.
+			uint64_t f;
+			int e;
+
+			DiyFp(uint64_t f, int e)
+				: f(f), e(e)
+			{
+				//do nothing
+			}
+
+			DiyFp operator-(const DiyFp& other) const
+			{
+				return DiyFp(f - other.f, e);
+			}
+
+			DiyFp operator*(const DiyFp& other) const
+			{
+				//Upper 64 bits of the 128 bit product, rounded.
+				const uint64_t lowMask = 0xFFFFFFFFULL;
+				const uint64_t a = f >> 32;
+				const uint64_t b = f & lowMask;
+				const uint64_t c = other.f >> 32;
+				const uint64_t d = other.f & lowMask;
+				const uint64_t ac = a * c;
+				const uint64_t bc = b * c;
+				const uint64_t ad = a * d;
+				const uint64_t bd = b * d;
+				uint64_t middle = (bd >> 32) + (ad & lowMask) + (bc & lowMask);
+				middle += 1ULL << 31;
+				return DiyFp(ac + (ad >> 32) + (bc >> 32) + (middle >> 32), e + other.e + 64);
+			}
+
+			DiyFp normalize() const
+			{
+				DiyFp result = *this;
+				while ((result.f & (1ULL << 63)) == 0)
+				{
+					result.f <<= 1;
+					result.e--;
+				}
+				return result;
+			}
+		};
+
+		template <typename Floating>
+		struct FloatingTraits;
+
+		template <>
+		struct FloatingTraits<double>
+		{
+			typedef uint64_t Bits;
+			static constexpr int SIGNIFICAND_BITS = 52;
+			static constexpr int EXPONENT_BIAS = 1075;
+			static constexpr uint64_t MAX_EXACT_SIGNIFICAND = 1ULL << 53;
+			static constexpr int MAX_EXACT_POWER_OF_TEN = 22;
+		};
+
+		template <>
+		struct FloatingTraits<float>
+		{
+			typedef uint32_t Bits;
+			static constexpr int SIGNIFICAND_BITS = 23;
+			static constexpr int EXPONENT_BIAS = 150;
+			static constexpr uint64_t MAX_EXACT_SIGNIFICAND = 1ULL << 24;
+			static constexpr int MAX_EXACT_POWER_OF_TEN = 10;
+		};
+
+		template <typename Floating>
+		void grisuBoundaries(Floating value, DiyFp& v, DiyFp& lower, DiyFp& upper)
+		{
+			//v is the value, lower and upper are the midpoints to its neighbours. All numbers between
+			//them read back as value.
+			typedef FloatingTraits<Floating> Traits;
+			typename Traits::Bits bits;
+			memcpy(&bits, &value, sizeof(bits));
+			const uint64_t hiddenBit = 1ULL << Traits::SIGNIFICAND_BITS;
+			const uint64_t significand = (uint64_t)bits & (hiddenBit - 1);
+			const int biasedExponent = (int)((uint64_t)bits >> Traits::SIGNIFICAND_BITS) & ((1 << (sizeof(Floating) * 8 - 1 - Traits::SIGNIFICAND_BITS)) - 1);
+			if (biasedExponent != 0)
+			{
+				v = DiyFp(significand + hiddenBit, biasedExponent - Traits::EXPONENT_BIAS);
+			}
+			else
+			{
+				v = DiyFp(significand, 1 - Traits::EXPONENT_BIAS);
+			}
+
+			upper = DiyFp((v.f << 1) + 1, v.e - 1).normalize();
+			if (v.f == hiddenBit && biasedExponent > 1)
+			{
+				//The gap to the next smaller value is only half as large.
+				lower = DiyFp((v.f << 2) - 1, v.e - 2);
+			}
+			else
+			{
+				lower = DiyFp((v.f << 1) - 1, v.e - 1);
+			}
+			lower.f <<= lower.e - upper.e;
+			lower.e = upper.e;
+			v = v.normalize();
+		}
+
+		inline DiyFp grisuCachedPower(int e, int& decimalExponent)
+		{
+			//Picks a power of ten that brings the product into the range [2^-60, 2^-32] * 2^64.
+			const double dk = (-61 - e) * 0.30102999566398114 + 347;
+			int k = (int)dk;
+			if (dk - k > 0.0)
+			{
+				k++;
+			}
+			const size_t index = (size_t)((k >> 3) + 1);
+			decimalExponent = -(-348 + (int)(index << 3));
+			return DiyFp(NUMBER_CACHED_POWERS_SIGNIFICAND[index], NUMBER_CACHED_POWERS_EXPONENT[index]);
+		}
+
+		inline void grisuRound(char* digits, size_t length, uint64_t delta, uint64_t rest, uint64_t tenKappa, uint64_t distance)
+		{
+			while (rest < distance && delta - rest >= tenKappa && (rest + tenKappa < distance || distance - rest > rest + tenKappa - distance))
+			{
+				digits[length - 1]--;
+				rest += tenKappa;
+			}
+		}
+
+		inline size_t grisuDigits(const DiyFp& w, const DiyFp& upper, uint64_t delta, char* digits, int& decimalExponent)
+		{
+			const DiyFp one(1ULL << -upper.e, upper.e);
+			const uint64_t distance = (upper - w).f;
+			uint32_t integral = (uint32_t)(upper.f >> -one.e);
+			uint64_t fractional = upper.f & (one.f - 1);
+			int kappa = 1;
+			while (kappa < 10 && integral >= NUMBER_POWERS_OF_TEN[kappa])
+			{
+				kappa++;
+			}
+
+			size_t length = 0;
+			while (kappa > 0)
+			{
+				const uint32_t divisor = (uint32_t)NUMBER_POWERS_OF_TEN[kappa - 1];
+				const uint32_t digit = integral / divisor;
+				integral %= divisor;
+				if (digit != 0 || length != 0)
+				{
+					digits[length++] = (char)('0' + digit);
+				}
+				kappa--;
+				const uint64_t rest = ((uint64_t)integral << -one.e) + fractional;
+				if (rest <= delta)
+				{
+					decimalExponent += kappa;
+					grisuRound(digits, length, delta, rest, NUMBER_POWERS_OF_TEN[kappa] << -one.e, distance);
+					return length;
+				}
+			}
+
+			while (true)
+			{
+				fractional *= 10;
+				delta *= 10;
+				const char digit = (char)(fractional >> -one.e);
+				if (digit != 0 || length != 0)
+				{
+					digits[length++] = (char)('0' + digit);
+				}
+				fractional &= one.f - 1;
+				kappa--;
+				if (fractional < delta)
+				{
+					decimalExponent += kappa;
+					const int index = -kappa;
+					grisuRound(digits, length, delta, fractional, one.f, index < 20 ? distance * NUMBER_POWERS_OF_TEN[index] : 0);
+					return length;
+				}
+			}
+		}
+
+		template <typename Floating>
+		size_t grisu2(Floating value, char* digits, int& decimalExponent)
+		{
+			//value has to be finite and positive. Writes at most 17 digits, value is digits * 10^decimalExponent.
+			DiyFp v(0, 0);
+			DiyFp lower(0, 0);
+			DiyFp upper(0, 0);
+			grisuBoundaries(value, v, lower, upper);
+			const DiyFp cachedPower = grisuCachedPower(upper.e, decimalExponent);
+			const DiyFp w = v * cachedPower;
+			DiyFp scaledUpper = upper * cachedPower;
+			DiyFp scaledLower = lower * cachedPower;
+			scaledLower.f++;
+			scaledUpper.f--;
+			return grisuDigits(w, scaledUpper, scaledUpper.f - scaledLower.f, digits, decimalExponent);
+		}
+
+		template <typename Char>
+		Char* writeExponent(int exponent, Char* out)
+		{
+			*out++ = 'e';
+			if (exponent < 0)
+			{
+				*out++ = '-';
+				exponent = -exponent;
+			}
+			else
+			{
+				*out++ = '+';
+			}
+			if (exponent >= 100)
+			{
+				*out++ = (Char)('0' + exponent / 100);
+				exponent %= 100;
+				*out++ = (Char)NUMBER_DIGIT_PAIRS[exponent * 2];
+				*out++ = (Char)NUMBER_DIGIT_PAIRS[exponent * 2 + 1];
+			}
+			else if (exponent >= 10)
+			{
+				*out++ = (Char)NUMBER_DIGIT_PAIRS[exponent * 2];
+				*out++ = (Char)NUMBER_DIGIT_PAIRS[exponent * 2 + 1];
+			}
+			else
+			{
+				*out++ = (Char)('0' + exponent);
+			}
+			return out;
+		}
+
+		template <typename Char>
+		Char* writeDecimal(const char* digits, size_t length, int decimalExponent, Char* out)
+		{
+			//The value is 0.digits * 10^point.
+			const int point = (int)length + decimalExponent;
+			if ((int)length <= point && point <= 21)
+			{
+				for (size_t i = 0; i < length; i++)
+				{
+					*out++ = (Char)digits[i];
+				}
+				for (int i = (int)length; i < point; i++)
+				{
+					*out++ = '0';
+				}
+			}
+			else if (0 < point && point <= 21)
+			{
+				for (int i = 0; i < point; i++)
+				{
+					*out++ = (Char)digits[i];
+				}
+				*out++ = '.';
+				for (size_t i = point; i < length; i++)
+				{
+					*out++ = (Char)digits[i];
+				}
+			}
+			else if (-6 < point && point <= 0)
+			{
+				*out++ = '0';
+				*out++ = '.';
+				for (int i = point; i < 0; i++)
+				{
+					*out++ = '0';
+				}
+				for (size_t i = 0; i < length; i++)
+				{
+					*out++ = (Char)digits[i];
+				}
+			}
+			else
+			{
+				*out++ = (Char)digits[0];
+				if (length > 1)
+				{
+					*out++ = '.';
+					for (size_t i = 1; i < length; i++)
+					{
+						*out++ = (Char)digits[i];
+					}
+				}
+				out = writeExponent(point - 1, out);
+			}
+			return out;
+		}
+
+		template <typename Char>
+		size_t formatUnsigned(unsigned long long value, bool negative, Char* out)
+		{
+			char digits[20];
+			char* start = digits + 20;
+			while (value >= 100)
+			{
+				const size_t pair = (size_t)(value % 100) * 2;
+				value /= 100;
+				*--start = NUMBER_DIGIT_PAIRS[pair + 1];
+				*--start = NUMBER_DIGIT_PAIRS[pair];
+			}
+			if (value >= 10)
+			{
+				*--start = NUMBER_DIGIT_PAIRS[value * 2 + 1];
+				*--start = NUMBER_DIGIT_PAIRS[value * 2];
+			}
+			else
+			{
+				*--start = (char)('0' + value);
+			}
+
+			Char* position = out;
+			if (negative)
+			{
+				*position++ = '-';
+			}
+			while (start != digits + 20)
+			{
+				*position++ = (Char)*start++;
+			}
+			*position = 0;
+			return position - out;
+		}
+
+		template <typename Char>
+		size_t formatSigned(long long value, Char* out)
+		{
+			if (value < 0)
+			{
+				return formatUnsigned(0ULL - (unsigned long long)value, true, out);
+			}
+			return formatUnsigned((unsigned long long)value, false, out);
+		}
+
+		template <typename Char, typename Floating>
+		size_t formatFloating(Floating value, Char* out)
+		{
+			Char* position = out;
+			if (std::isnan(value))
+			{
+				*position++ = 'n';
+				*position++ = 'a';
+				*position++ = 'n';
+				*position = 0;
+				return position - out;
+			}
+			if (std::signbit(value))
+			{
+				*position++ = '-';
+				value = -value;
+			}
+			if (std::isinf(value))
+			{
+				*position++ = 'i';
+				*position++ = 'n';
+				*position++ = 'f';
+			}
+			else if (value == 0)
+			{
+				*position++ = '0';
+			}
+			else
+			{
+				char digits[20];
+				int decimalExponent = 0;
+				const size_t length = grisu2(value, digits, decimalExponent);
+				position = writeDecimal(digits, length, decimalExponent, position);
+			}
+			*position = 0;
+			return position - out;
+		}
+
+		template <typename Char>
+		bool matchesIgnoringCase(const Char* begin, const Char* end, const char* word)
+		{
+			for (; *word != 0; word++, begin++)
+			{
+				if (begin == end || (*begin | 0x20) != *word)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		template <typename Char>
+		int digitValue(Char c)
+		{
+			if (c >= '0' && c <= '9')
+			{
+				return (int)(c - '0');
+			}
+			if (c >= 'a' && c <= 'z')
+			{
+				return (int)(c - 'a') + 10;
+			}
+			if (c >= 'A' && c <= 'Z')
+			{
+				return (int)(c - 'A') + 10;
+			}
+			return INT_MAX;
+		}
+
+		template <typename Char>
+		NumberParseResult<Char> parseMagnitude(const Char* begin, const Char* end, int base, unsigned long long& magnitude, bool& overflow)
+		{
+			//base 0 detects the base from the prefix like strtol: 0x is hexadecimal, 0 octal.
+			const Char* position = begin;
+			if ((base == 0 || base == 16) && end - position >= 3 && position[0] == '0' && (position[1] | 0x20) == 'x' && digitValue(position[2]) < 16)
+			{
+				position += 2;
+				base = 16;
+			}
+			else if (base == 0)
+			{
+				base = position != end && *position == '0' ? 8 : 10;
+			}
+			if (base < 2 || base > 36)
+			{
+				return NumberParseResult<Char>{ begin, NumberParseError::INVALID_ARGUMENT };
+			}
+
+			const Char* digitsBegin = position;
+			magnitude = 0;
+			overflow = false;
+			for (; position != end; position++)
+			{
+				const int digit = digitValue(*position);
+				if (digit >= base)
+				{
+					break;
+				}
+				if (magnitude > (ULLONG_MAX - digit) / base)
+				{
+					overflow = true;
+				}
+				else
+				{
+					magnitude = magnitude * base + digit;
+				}
+			}
+			if (position == digitsBegin)
+			{
+				return NumberParseResult<Char>{ begin, NumberParseError::INVALID_ARGUMENT };
+			}
+			return NumberParseResult<Char>{ position, NumberParseError::NONE };
+		}
+
+		static const double NUMBER_POWERS_OF_TEN_FLOATING[23] = {
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+		};
+
+		template <typename Floating>
+		Floating parseFloatingSlow(const char* text);
+
+		template <>
+		inline double parseFloatingSlow<double>(const char* text)
+		{
+			return strtod(text, nullptr);
+		}
+
+		template <>
+		inline float parseFloatingSlow<float>(const char* text)
+		{
+			return strtof(text, nullptr);
+		}
+
+		template <typename Char, typename Floating>
+		NumberParseResult<Char> parseFloating(const Char* begin, const Char* end, Floating& out)
+		{
+			typedef FloatingTraits<Floating> Traits;
+			//Enough significant digits to round every double correctly, the rest only decides between
+			//exactly halfway and slightly above.
+			static constexpr size_t MAX_DIGITS = 800;
+
+			const Char* position = begin;
+			bool negative = false;
+			if (position != end && (*position == '-' || *position == '+'))
+			{
+				negative = *position == '-';
+				position++;
+			}
+			if (matchesIgnoringCase(position, end, "inf"))
+			{
+				position += matchesIgnoringCase(position, end, "infinity") ? 8 : 3;
+				out = negative ? -HUGE_VAL : HUGE_VAL;
+				return NumberParseResult<Char>{ position, NumberParseError::NONE };
+			}
+			if (matchesIgnoringCase(position, end, "nan"))
+			{
+				out = (Floating)(negative ? -NAN : NAN);
+				return NumberParseResult<Char>{ position + 3, NumberParseError::NONE };
+			}
+
+			//The digits are collected without leading zeros and without the point, which is accounted
+			//for in the exponent instead.
+			char digits[MAX_DIGITS + 2];
+			size_t amountOfDigits = 0;
+			bool droppedNonZero = false;
+			uint64_t significand = 0;
+			long long exponent = 0;
+			bool anyDigits = false;
+			bool afterPoint = false;
+			for (; position != end; position++)
+			{
+				const Char c = *position;
+				if (c == '.' && !afterPoint)
+				{
+					afterPoint = true;
+					continue;
+				}
+				if (c < '0' || c > '9')
+				{
+					break;
+				}
+				anyDigits = true;
+				if (amountOfDigits == 0 && c == '0')
+				{
+					if (afterPoint)
+					{
+						exponent--;
+					}
+					continue;
+				}
+				if (amountOfDigits < MAX_DIGITS)
+				{
+					if (amountOfDigits < 19)
+					{
+						significand = significand * 10 + (c - '0');
+					}
+					digits[amountOfDigits++] = (char)c;
+					if (afterPoint)
+					{
+						exponent--;
+					}
+				}
+				else
+				{
+					droppedNonZero |= c != '0';
+					if (!afterPoint)
+					{
+						exponent++;
+					}
+				}
+			}
+			if (!anyDigits)
+			{
+				return NumberParseResult<Char>{ begin, NumberParseError::INVALID_ARGUMENT };
+			}
+
+			if (position != end && (*position == 'e' || *position == 'E'))
+			{
+				const Char* exponentPosition = position + 1;
+				bool negativeExponent = false;
+				if (exponentPosition != end && (*exponentPosition == '-' || *exponentPosition == '+'))
+				{
+					negativeExponent = *exponentPosition == '-';
+					exponentPosition++;
+				}
+				if (exponentPosition != end && *exponentPosition >= '0' && *exponentPosition <= '9')
+				{
+					long long explicitExponent = 0;
+					for (; exponentPosition != end && *exponentPosition >= '0' && *exponentPosition <= '9'; exponentPosition++)
+					{
+						if (explicitExponent < 100000)
+						{
+							explicitExponent = explicitExponent * 10 + (*exponentPosition - '0');
+						}
+					}
+					exponent += negativeExponent ? -explicitExponent : explicitExponent;
+					position = exponentPosition;
+				}
+			}
+
+			if (amountOfDigits == 0)
+			{
+				out = negative ? -(Floating)0 : (Floating)0;
+				return NumberParseResult<Char>{ position, NumberParseError::NONE };
+			}
+
+			if (amountOfDigits <= 19 && significand <= Traits::MAX_EXACT_SIGNIFICAND && exponent >= -Traits::MAX_EXACT_POWER_OF_TEN && exponent <= Traits::MAX_EXACT_POWER_OF_TEN)
+			{
+				//Clinger's fast path: both factors are exact, so the single rounding is correct.
+				Floating value = (Floating)significand;
+				if (exponent < 0)
+				{
+					value /= (Floating)NUMBER_POWERS_OF_TEN_FLOATING[-exponent];
+				}
+				else
+				{
+					value *= (Floating)NUMBER_POWERS_OF_TEN_FLOATING[exponent];
+				}
+				out = negative ? -value : value;
+				return NumberParseResult<Char>{ position, NumberParseError::NONE };
+			}
+
+			//Digits and exponent without a decimal point do not depend on the locale.
+			char text[MAX_DIGITS + 32];
+			size_t length = 0;
+			if (negative)
+			{
+				text[length++] = '-';
+			}
+			memcpy(text + length, digits, amountOfDigits);
+			length += amountOfDigits;
+			if (droppedNonZero)
+			{
+				text[length++] = '1';
+				exponent--;
+			}
+			text[length++] = 'e';
+			length += formatSigned(exponent, text + length);
+			errno = 0;
+			out = parseFloatingSlow<Floating>(text);
+			//Subnormal results also set ERANGE, only overflow to infinity and underflow to 0 are errors.
+			if (errno == ERANGE && (std::isinf(out) || out == 0))
+			{
+				return NumberParseResult<Char>{ position, NumberParseError::OUT_OF_RANGE };
+			}
+			return NumberParseResult<Char>{ position, NumberParseError::NONE };
+		}
+	}
+
+	template <typename Char>
+	size_t formatNumber(long long value, Char* out)
+	{
+		//Writes at most NUMBER_FORMAT_MAX_LENGTH characters including the terminating 0 and returns
+		//the length without it.
+		return INTERNAL::formatSigned(value, out);
+	}
+
+	template <typename Char>
+	size_t formatNumber(unsigned long long value, Char* out)
+	{
+		return INTERNAL::formatUnsigned(value, false, out);
+	}
+
+	template <typename Char>
+	size_t formatNumber(double value, Char* out)
+	{
+		return INTERNAL::formatFloating(value, out);
+	}
+
+	template <typename Char>
+	size_t formatNumber(float value, Char* out)
+	{
+		//Digits that read back to the same float, usually the shortest, so 0.1f is 0.1 and not 0.10000000149011612.
+		return INTERNAL::formatFloating(value, out);
+	}
+
+	template <typename Char>
+	NumberParseResult<Char> parseNumber(const Char* begin, const Char* end, long long& out, int base = 10)
+	{
+		//On OUT_OF_RANGE, out is clamped to the closest representable value.
+		const Char* position = begin;
+		bool negative = false;
+		if (position != end && (*position == '-' || *position == '+'))
+		{
+			negative = *position == '-';
+			position++;
+		}
+		unsigned long long magnitude = 0;
+		bool overflow = false;
+		NumberParseResult<Char> result = INTERNAL::parseMagnitude(position, end, base, magnitude, overflow);
+		if (result.error != NumberParseError::NONE)
+		{
+			result.end = begin;
+			return result;
+		}
+		const unsigned long long limit = negative ? 0ULL - (unsigned long long)LLONG_MIN : (unsigned long long)LLONG_MAX;
+		if (overflow || magnitude > limit)
+		{
+			out = negative ? LLONG_MIN : LLONG_MAX;
+			result.error = NumberParseError::OUT_OF_RANGE;
+			return result;
+		}
+		out = negative ? (long long)(0ULL - magnitude) : (long long)magnitude;
+		return result;
+	}
+
+	template <typename Char>
+	NumberParseResult<Char> parseNumber(const Char* begin, const Char* end, unsigned long long& out, int base = 10)
+	{
+		unsigned long long magnitude = 0;
+		bool overflow = false;
+		NumberParseResult<Char> result = INTERNAL::parseMagnitude(begin, end, base, magnitude, overflow);
+		if (result.error != NumberParseError::NONE)
+		{
+			return result;
+		}
+		if (overflow)
+		{
+			out = ULLONG_MAX;
+			result.error = NumberParseError::OUT_OF_RANGE;
+			return result;
+		}
+		out = magnitude;
+		return result;
+	}
+
+	template <typename Char>
+	NumberParseResult<Char> parseNumber(const Char* begin, const Char* end, double& out)
+	{
+		//Accepts an optional sign, digits with an optional point, an optional exponent, inf, infinity
+		//and nan. The result is correctly rounded.
+		return INTERNAL::parseFloating(begin, end, out);
+	}
+
+	template <typename Char>
+	NumberParseResult<Char> parseNumber(const Char* begin, const Char* end, float& out)
+	{
+		return INTERNAL::parseFloating(begin, end, out);
+	}
+
+	namespace INTERNAL
+	{
+		class NumberBuffer
+		{
+			//Formats a number on the stack, so that it can be appended to a String without a temporary.
+		private:
+			wchar_t m_data[NUMBER_FORMAT_MAX_LENGTH];
+			size_t m_length;
+
+		public:
+			explicit NumberBuffer(int number)
+				: m_length(formatNumber((long long)number, m_data))
+			{
+				//do nothing
+			}
+
+			explicit NumberBuffer(long number)
+				: m_length(formatNumber((long long)number, m_data))
+			{
+				//do nothing
+			}
+
+			explicit NumberBuffer(long long number)
+				: m_length(formatNumber(number, m_data))
+			{
+				//do nothing
+			}
+
+			explicit NumberBuffer(unsigned int number)
+				: m_length(formatNumber((unsigned long long)number, m_data))
+			{
+				//do nothing
+			}
+
+			explicit NumberBuffer(unsigned long number)
+				: m_length(formatNumber((unsigned long long)number, m_data))
+			{
+				//do nothing
+			}
+
+			explicit NumberBuffer(unsigned long long number)
+				: m_length(formatNumber(number, m_data))
+			{
+				//do nothing
+			}
+
+			explicit NumberBuffer(float number)
+				: m_length(formatNumber(number, m_data))
+			{
+				//do nothing
+			}
+
+			explicit NumberBuffer(double number)
+				: m_length(formatNumber(number, m_data))
+			{
+				//do nothing
+			}
+
+			explicit NumberBuffer(long double number)
+				: m_length(formatNumber((double)number, m_data))
+			{
+				//do nothing
+			}
+
+			NumberBuffer(const NumberBuffer& other) = delete;
+			NumberBuffer& operator=(const NumberBuffer& other) = delete;
+
+			StringView getView() const
+			{
+				return StringView(m_data, m_length);
+			}
+		};
+	}
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include "NumberConversion.h"
+#include "String.h"
+#include "UtilTest.h"
+
+namespace bbe
+{
+	namespace test
+	{
+		template <typename Number>
+		String formatNumberToString(Number number)
+		{
+			wchar_t buffer[NUMBER_FORMAT_MAX_LENGTH];
+			const size_t length = formatNumber(number, buffer);
+			assertEquals(buffer[length], L'\0');
+			return String(buffer);
+		}
+
+		template <typename Number>
+		NumberParseError parseNumberFromText(const char* text, Number& out, size_t expectedLength)
+		{
+			NumberParseResult<char> result = parseNumber(text, text + strlen(text), out);
+			assertEquals((size_t)(result.end - text), expectedLength);
+			return result.error;
+		}
+
+		void testNumberConversion()
+		{
+			{
+				assertEquals(formatNumberToString(0LL), "0");
+				assertEquals(formatNumberToString(7LL), "7");
+				assertEquals(formatNumberToString(42LL), "42");
+				assertEquals(formatNumberToString(-1928LL), "-1928");
+				assertEquals(formatNumberToString(LLONG_MIN), "-9223372036854775808");
+				assertEquals(formatNumberToString(LLONG_MAX), "9223372036854775807");
+				assertEquals(formatNumberToString(ULLONG_MAX), "18446744073709551615");
+			}
+
+			{
+				assertEquals(formatNumberToString(0.0), "0");
+				assertEquals(formatNumberToString(-0.0), "-0");
+				assertEquals(formatNumberToString(1.0), "1");
+				assertEquals(formatNumberToString(-1.5), "-1.5");
+				assertEquals(formatNumberToString(2839.192), "2839.192");
+				assertEquals(formatNumberToString(0.1), "0.1");
+				assertEquals(formatNumberToString(0.1 + 0.2), "0.30000000000000004");
+				assertEquals(formatNumberToString(0.000001), "0.000001");
+				assertEquals(formatNumberToString(1e-7), "1e-7");
+				assertEquals(formatNumberToString(123e18), "123000000000000000000");
+				assertEquals(formatNumberToString(1e21), "1e+21");
+				assertEquals(formatNumberToString(DBL_MAX), "1.7976931348623157e+308");
+				assertEquals(formatNumberToString(5e-324), "5e-324");
+				assertEquals(formatNumberToString(0.1f), "0.1");
+				assertEquals(formatNumberToString(16777216.0f), "16777216");
+				assertEquals(formatNumberToString(HUGE_VAL), "inf");
+				assertEquals(formatNumberToString(-HUGE_VAL), "-inf");
+				assertEquals(formatNumberToString(NAN), "nan");
+			}
+
+			{
+				//Every finite value has to read back exactly.
+				uint64_t random = 12345;
+				for (int i = 0; i < 20000; i++)
+				{
+					random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+					double value;
+					memcpy(&value, &random, sizeof(value));
+					if (!std::isfinite(value))
+					{
+						continue;
+					}
+					wchar_t buffer[NUMBER_FORMAT_MAX_LENGTH];
+					const size_t length = formatNumber(value, buffer);
+					double parsed = 0;
+					NumberParseResult<wchar_t> result = parseNumber(buffer, buffer + length, parsed);
+					assertEquals(result.error, NumberParseError::NONE);
+					assertEquals(result.end, buffer + length);
+					assertEquals(parsed, value);
+
+					const uint32_t floatBits = (uint32_t)(random >> 32);
+					float floatValue;
+					memcpy(&floatValue, &floatBits, sizeof(floatValue));
+					if (!std::isfinite(floatValue))
+					{
+						continue;
+					}
+					const size_t floatLength = formatNumber(floatValue, buffer);
+					float parsedFloat = 0;
+					parseNumber(buffer, buffer + floatLength, parsedFloat);
+					assertEquals(parsedFloat, floatValue);
+				}
+			}
+
+			{
+				double value = 0;
+				assertEquals(parseNumberFromText("1928.5", value, 6), NumberParseError::NONE);
+				assertEquals(value, 1928.5);
+				assertEquals(parseNumberFromText("-12.5e3 meters", value, 7), NumberParseError::NONE);
+				assertEquals(value, -12500.0);
+				assertEquals(parseNumberFromText(".5", value, 2), NumberParseError::NONE);
+				assertEquals(value, 0.5);
+				assertEquals(parseNumberFromText("3e", value, 1), NumberParseError::NONE);
+				assertEquals(value, 3.0);
+				assertEquals(parseNumberFromText("0.1", value, 3), NumberParseError::NONE);
+				assertEquals(value, 0.1);
+				assertEquals(parseNumberFromText("9007199254740993", value, 16), NumberParseError::NONE);
+				assertEquals(value, 9007199254740992.0);
+				assertEquals(parseNumberFromText("2.2250738585072011e-308", value, 23), NumberParseError::NONE);
+				assertEquals(value, 2.2250738585072011e-308);
+				assertEquals(parseNumberFromText("0.000000000000000000000000000001234567890123456789012", value, 53), NumberParseError::NONE);
+				assertEquals(value, 1.234567890123456789012e-30);
+				assertEquals(parseNumberFromText("-Infinity", value, 9), NumberParseError::NONE);
+				assertEquals(value, -HUGE_VAL);
+
+				value = 7;
+				assertEquals(parseNumberFromText("abc", value, 0), NumberParseError::INVALID_ARGUMENT);
+				assertEquals(parseNumberFromText(" 1", value, 0), NumberParseError::INVALID_ARGUMENT);
+				assertEquals(parseNumberFromText(".", value, 0), NumberParseError::INVALID_ARGUMENT);
+				assertEquals(value, 7.0);
+				assertEquals(parseNumberFromText("1e400", value, 5), NumberParseError::OUT_OF_RANGE);
+				assertEquals(value, HUGE_VAL);
+
+				float floatValue = 0;
+				assertEquals(parseNumberFromText("1928.5", floatValue, 6), NumberParseError::NONE);
+				assertEquals(floatValue, 1928.5f);
+				assertEquals(parseNumberFromText("3.4028235e38", floatValue, 12), NumberParseError::NONE);
+				assertEquals(floatValue, FLT_MAX);
+			}
+
+			{
+				long long value = 0;
+				assertEquals(parseNumberFromText("1282 apples", value, 4), NumberParseError::NONE);
+				assertEquals(value, 1282);
+				assertEquals(parseNumberFromText("-9223372036854775808", value, 20), NumberParseError::NONE);
+				assertEquals(value, LLONG_MIN);
+				assertEquals(parseNumberFromText("9223372036854775808", value, 19), NumberParseError::OUT_OF_RANGE);
+				assertEquals(value, LLONG_MAX);
+				assertEquals(parseNumberFromText("-", value, 0), NumberParseError::INVALID_ARGUMENT);
+
+				const char* hex = "0xff";
+				assertEquals(parseNumber(hex, hex + 4, value, 16).error, NumberParseError::NONE);
+				assertEquals(value, 255);
+				const char* binary = "1012";
+				assertEquals(parseNumber(binary, binary + 4, value, 2).end, binary + 3);
+				assertEquals(value, 5);
+
+				unsigned long long unsignedValue = 0;
+				assertEquals(parseNumberFromText("18446744073709551615", unsignedValue, 20), NumberParseError::NONE);
+				assertEquals(unsignedValue, ULLONG_MAX);
+				assertEquals(parseNumberFromText("18446744073709551616", unsignedValue, 20), NumberParseError::OUT_OF_RANGE);
+				assertEquals(parseNumberFromText("-1", unsignedValue, 0), NumberParseError::INVALID_ARGUMENT);
+			}
+
+			{
+				String number("  -2.5e2");
+				assertEquals(number.toDouble(), -250.0);
+				assertEquals(number.toLong(), -2);
+				double value = 0;
+				assertEquals(number.parseNumber(value), NumberParseError::INVALID_ARGUMENT);
+				assertEquals(String("-2.5e2").parseNumber(value), NumberParseError::NONE);
+				assertEquals(value, -250.0);
+				long long integer = 0;
+				assertEquals(String("12a").parseNumber(integer), NumberParseError::INVALID_ARGUMENT);
+				assertEquals(String("12a").parseNumber(integer, 16), NumberParseError::NONE);
+				assertEquals(integer, 0x12a);
+
+				assertEquals(String(1.5f), "1.5");
+				assertEquals(String(-17), "-17");
+				assertEquals(String("x = ") + 0.25, "x = 0.25");
+				assertEquals(3u + String(" apples"), "3 apples");
+				String appended("n");
+				appended += 1e100;
+				assertEquals(appended, "n1e+100");
+			}
+		}
+	}
+}
\ No newline at end of file
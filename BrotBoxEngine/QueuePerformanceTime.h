@@ -0,0 +1,140 @@
+#pragma once
+
+#include "SPSCQueue.h"
+#include "MPMCQueue.h"
+#include <iostream>
+#include <thread>
+#include "StopWatch.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace bbe
+{
+	namespace test
+	{
+		void queuePinThreadToCore(std::thread& thread, size_t core)
+		{
+			//Without pinning, the scheduler may put both threads on the same core and the
+			//numbers would not tell anything about cache line transfers.
+#ifdef _WIN32
+			SetThreadAffinityMask(thread.native_handle(), (DWORD_PTR)1 << core);
+#else
+			cpu_set_t cpuSet;
+			CPU_ZERO(&cpuSet);
+			CPU_SET(core, &cpuSet);
+			pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuSet);
+#endif
+		}
+
+		template <typename Queue>
+		double queueMeasureThroughput(size_t producerCore, size_t consumerCore, size_t amountOfValues)
+		{
+			//Returns the nanoseconds per transferred value.
+			Queue queue(1024);
+			StopWatch sw;
+			std::thread producer(
+				[&]()
+				{
+					for (size_t i = 0; i < amountOfValues; i++)
+					{
+						while (!queue.push(i))
+						{
+							//do nothing
+						}
+					}
+				});
+			std::thread consumer(
+				[&]()
+				{
+					size_t value = 0;
+					for (size_t i = 0; i < amountOfValues; i++)
+					{
+						while (!queue.pop(value))
+						{
+							//do nothing
+						}
+					}
+				});
+			queuePinThreadToCore(producer, producerCore);
+			queuePinThreadToCore(consumer, consumerCore);
+			producer.join();
+			consumer.join();
+			return (double)sw.getTimeExpiredNanoseconds() / amountOfValues;
+		}
+
+		template <typename Queue>
+		double queueMeasureRoundTrip(size_t pingCore, size_t pongCore, size_t amountOfRoundTrips)
+		{
+			//Returns the nanoseconds per round trip. Every value is sent back before the next one is
+			//sent, so this measures the latency of two cache line transfers in each direction.
+			Queue ping(16);
+			Queue pong(16);
+			StopWatch sw;
+			std::thread pinger(
+				[&]()
+				{
+					size_t value = 0;
+					for (size_t i = 0; i < amountOfRoundTrips; i++)
+					{
+						while (!ping.push(i))
+						{
+							//do nothing
+						}
+						while (!pong.pop(value))
+						{
+							//do nothing
+						}
+					}
+				});
+			std::thread ponger(
+				[&]()
+				{
+					size_t value = 0;
+					for (size_t i = 0; i < amountOfRoundTrips; i++)
+					{
+						while (!ping.pop(value))
+						{
+							//do nothing
+						}
+						while (!pong.push(value))
+						{
+							//do nothing
+						}
+					}
+				});
+			queuePinThreadToCore(pinger, pingCore);
+			queuePinThreadToCore(ponger, pongCore);
+			pinger.join();
+			ponger.join();
+			return (double)sw.getTimeExpiredNanoseconds() / amountOfRoundTrips;
+		}
+
+		void queuePrintLatencyAndThroughput()
+		{
+			constexpr size_t amountOfValues = 10000000;
+			constexpr size_t amountOfRoundTrips = 1000000;
+			const size_t amountOfCores = std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() : 2;
+
+			while (true)
+			{
+				for (size_t core = 1; core < amountOfCores; core++)
+				{
+					std::cout << "Cores 0 <-> " << core << std::endl;
+					std::cout << "SPSCQueue throughput: " << queueMeasureThroughput<SPSCQueue<size_t>>(0, core, amountOfValues) << " ns/op" << std::endl;
+					std::cout << "MPMCQueue throughput: " << queueMeasureThroughput<MPMCQueue<size_t>>(0, core, amountOfValues) << " ns/op" << std::endl;
+					std::cout << "SPSCQueue round trip: " << queueMeasureRoundTrip<SPSCQueue<size_t>>(0, core, amountOfRoundTrips) << " ns/op" << std::endl;
+					std::cout << "MPMCQueue round trip: " << queueMeasureRoundTrip<MPMCQueue<size_t>>(0, core, amountOfRoundTrips) << " ns/op" << std::endl;
+				}
+				std::cout << std::endl;
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+#pragma once
+
+#include "SPSCQueue.h"
+#include "MPMCQueue.h"
+#include "List.h"
+#include "UtilTest.h"
+#include <thread>
+
+namespace bbe
+{
+	namespace test
+	{
+		void _testSPSCQueue()
+		{
+			{
+				SPSCQueue<int> queue(5);
+				assertEquals(queue.getCapacity(), 8);
+				assertEquals(queue.isEmpty(), true);
+
+				int value = 0;
+				assertEquals(queue.pop(value), false);
+				for (int i = 0; i < 8; i++)
+				{
+					assertEquals(queue.push(i), true);
+				}
+				assertEquals(queue.push(8), false);
+				assertEquals(queue.getLength(), 8);
+
+				for (int i = 0; i < 8; i++)
+				{
+					assertEquals(queue.pop(value), true);
+					assertEquals(value, i);
+				}
+				assertEquals(queue.pop(value), false);
+
+				int values[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+				int out[10] = {};
+				assertEquals(queue.pushBatch(values, 10), 8);
+				assertEquals(queue.popBatch(out, 3), 3);
+				assertEquals(out[0], 0);
+				assertEquals(out[2], 2);
+				assertEquals(queue.pushBatch(values, 10), 3);
+				assertEquals(queue.popBatch(out, 10), 8);
+				assertEquals(out[0], 3);
+				assertEquals(out[4], 7);
+				assertEquals(out[5], 0);
+				assertEquals(out[7], 2);
+			}
+
+			{
+				SPSCQueue<Person> queue(4);
+				queue.push(Person("Name 1", "Addr 1", 1));
+				queue.push(Person("Name 2", "Addr 2", 2));
+				Person person;
+				assertEquals(queue.pop(person), true);
+				assertEquals(person.name, "Name 1");
+			}
+
+			Person::checkIfAllPersonsWereDestroyed();
+
+			{
+				constexpr size_t amountOfValues = 1000000;
+				SPSCQueue<size_t> queue(256);
+				std::thread producer(
+					[&]()
+					{
+						for (size_t i = 0; i < amountOfValues; i++)
+						{
+							while (!queue.push(i))
+							{
+								std::this_thread::yield();
+							}
+						}
+					});
+				size_t expected = 0;
+				size_t buffer[32];
+				while (expected < amountOfValues)
+				{
+					size_t amount = queue.popBatch(buffer, 32);
+					for (size_t i = 0; i < amount; i++)
+					{
+						assertEquals(buffer[i], expected);
+						expected++;
+					}
+				}
+				producer.join();
+			}
+		}
+
+		void _testMPMCQueue()
+		{
+			{
+				MPMCQueue<int> queue(8);
+				assertEquals(queue.getCapacity(), 8);
+
+				int value = 0;
+				assertEquals(queue.pop(value), false);
+				for (int i = 0; i < 8; i++)
+				{
+					assertEquals(queue.push(i), true);
+				}
+				assertEquals(queue.push(8), false);
+				for (int i = 0; i < 8; i++)
+				{
+					assertEquals(queue.pop(value), true);
+					assertEquals(value, i);
+				}
+				assertEquals(queue.pop(value), false);
+
+				int values[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+				int out[10] = {};
+				assertEquals(queue.pushBatch(values, 10), 8);
+				assertEquals(queue.popBatch(out, 10), 8);
+				assertEquals(out[7], 7);
+			}
+
+			{
+				MPMCQueue<Person> queue(4);
+				queue.push(Person("Name 1", "Addr 1", 1));
+				queue.push(Person("Name 2", "Addr 2", 2));
+				Person person;
+				assertEquals(queue.pop(person), true);
+				assertEquals(person.name, "Name 1");
+			}
+
+			Person::checkIfAllPersonsWereDestroyed();
+
+			{
+				constexpr size_t amountOfThreads = 4;
+				constexpr size_t amountOfValuesPerThread = 100000;
+				MPMCQueue<size_t> queue(64);
+				std::atomic<size_t> sum(0);
+				std::atomic<size_t> popped(0);
+				List<std::thread*> threads;
+				for (size_t t = 0; t < amountOfThreads; t++)
+				{
+					threads.pushBack(new std::thread(
+						[&]()
+						{
+							for (size_t i = 1; i <= amountOfValuesPerThread; i++)
+							{
+								while (!queue.push(i))
+								{
+									std::this_thread::yield();
+								}
+							}
+						}));
+					threads.pushBack(new std::thread(
+						[&]()
+						{
+							size_t buffer[8];
+							while (popped.load() < amountOfThreads * amountOfValuesPerThread)
+							{
+								size_t amount = queue.popBatch(buffer, 8);
+								for (size_t i = 0; i < amount; i++)
+								{
+									sum += buffer[i];
+								}
+								popped += amount;
+								if (amount == 0)
+								{
+									std::this_thread::yield();
+								}
+							}
+						}));
+				}
+				for (size_t t = 0; t < threads.getLength(); t++)
+				{
+					threads[t]->join();
+					delete threads[t];
+				}
+				assertEquals(popped.load(), amountOfThreads * amountOfValuesPerThread);
+				assertEquals(sum.load(), amountOfThreads * amountOfValuesPerThread * (amountOfValuesPerThread + 1) / 2);
+			}
+		}
+
+		void testQueue()
+		{
+			_testSPSCQueue();
+			_testMPMCQueue();
+		}
+	}
+}
\ No newline at end of file
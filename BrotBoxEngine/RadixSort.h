@@ -0,0 +1,208 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "DynamicArray.h"
+#include "List.h"
+
+namespace bbe
+{
+	//Order preserving transforms of primitive keys into unsigned keys. Comparing the results as
+	//unsigned integers gives the same order as comparing the inputs.
+	inline uint8_t radixSortKey(uint8_t key)
+	{
+		return key;
+	}
+
+	inline uint16_t radixSortKey(uint16_t key)
+	{
+		return key;
+	}
+
+	inline uint32_t radixSortKey(uint32_t key)
+	{
+		return key;
+	}
+
+	inline uint64_t radixSortKey(uint64_t key)
+	{
+		return key;
+	}
+
+	inline uint32_t radixSortKey(int32_t key)
+	{
+		return (uint32_t)key ^ 0x80000000u;
+	}
+
+	inline uint64_t radixSortKey(int64_t key)
+	{
+		return (uint64_t)key ^ 0x8000000000000000ull;
+	}
+
+	inline uint32_t radixSortKey(float key)
+	{
+		//Negative floats have all bits flipped, positive floats only the sign bit. -0.0f sorts before 0.0f.
+		uint32_t bits;
+		memcpy(&bits, &key, sizeof(bits));
+		const uint32_t mask = (bits & 0x80000000u) ? 0xFFFFFFFFu : 0x80000000u;
+		return bits ^ mask;
+	}
+
+	inline uint64_t radixSortKey(double key)
+	{
+		uint64_t bits;
+		memcpy(&bits, &key, sizeof(bits));
+		const uint64_t mask = (bits & 0x8000000000000000ull) ? 0xFFFFFFFFFFFFFFFFull : 0x8000000000000000ull;
+		return bits ^ mask;
+	}
+
+	namespace INTERNAL
+	{
+		static constexpr size_t RADIX_SORT_BUCKETS = 256;
+		static constexpr size_t RADIX_SORT_MIN_LENGTH_PER_HISTOGRAM_THREAD = 1 << 16;
+
+		template <typename T, typename KeyExtractor, typename Key>
+		void radixSortHistogram(const T* data, size_t length, KeyExtractor& extractor, size_t (*histograms)[RADIX_SORT_BUCKETS])
+		{
+			for (size_t i = 0; i < length; i++)
+			{
+				Key key = extractor(data[i]);
+				for (size_t digit = 0; digit < sizeof(Key); digit++)
+				{
+					histograms[digit][key & 0xFF]++;
+					key >>= 8;
+				}
+			}
+		}
+	}
+
+	template <typename T, typename KeyExtractor>
+	void radixSort(T* data, size_t length, KeyExtractor extractor, bool multiThreadedHistogram = false)
+	{
+		//Stable LSD radix sort with 8 bit digits. extractor(const T&) must return an unsigned integer,
+		//radixSortKey converts floats and signed integers. The histograms of all digits are built in a
+		//single pass; digits that are equal for all elements skip their scatter pass. T has to be
+		//default constructible and move assignable, as the scatter passes need a second buffer.
+		typedef typename std::decay<decltype(extractor(*data))>::type Key;
+		static_assert(std::is_integral<Key>::value && std::is_unsigned<Key>::value, "The key of a radixSort must be an unsigned integer!");
+
+		if (length < 2)
+		{
+			return;
+		}
+
+		size_t histograms[sizeof(Key)][INTERNAL::RADIX_SORT_BUCKETS] = {};
+		size_t amountOfThreads = multiThreadedHistogram ? std::thread::hardware_concurrency() : 1;
+		if (amountOfThreads > length / INTERNAL::RADIX_SORT_MIN_LENGTH_PER_HISTOGRAM_THREAD)
+		{
+			amountOfThreads = length / INTERNAL::RADIX_SORT_MIN_LENGTH_PER_HISTOGRAM_THREAD;
+		}
+		if (amountOfThreads <= 1)
+		{
+			INTERNAL::radixSortHistogram<T, KeyExtractor, Key>(data, length, extractor, histograms);
+		}
+		else
+		{
+			constexpr size_t histogramSize = sizeof(Key) * INTERNAL::RADIX_SORT_BUCKETS;
+			DynamicArray<size_t> threadHistograms(amountOfThreads * histogramSize, 0);
+			List<std::thread*> threads;
+			const size_t lengthPerThread = length / amountOfThreads;
+			for (size_t t = 0; t < amountOfThreads; t++)
+			{
+				size_t* histogram = threadHistograms.getRaw() + t * histogramSize;
+				const size_t start = t * lengthPerThread;
+				const size_t end = t == amountOfThreads - 1 ? length : start + lengthPerThread;
+				threads.pushBack(new std::thread(
+					[=, &extractor]()
+					{
+						INTERNAL::radixSortHistogram<T, KeyExtractor, Key>(data + start, end - start, extractor, reinterpret_cast<size_t(*)[INTERNAL::RADIX_SORT_BUCKETS]>(histogram));
+					}));
+			}
+			for (size_t t = 0; t < amountOfThreads; t++)
+			{
+				threads[t]->join();
+				delete threads[t];
+				const size_t* histogram = threadHistograms.getRaw() + t * histogramSize;
+				for (size_t i = 0; i < histogramSize; i++)
+				{
+					histograms[i / INTERNAL::RADIX_SORT_BUCKETS][i % INTERNAL::RADIX_SORT_BUCKETS] += histogram[i];
+				}
+			}
+		}
+
+		T* buffer = nullptr;
+		T* source = data;
+		for (size_t digit = 0; digit < sizeof(Key); digit++)
+		{
+			size_t* histogram = histograms[digit];
+			if (histogram[(extractor(source[0]) >> (digit * 8)) & 0xFF] == length)
+			{
+				continue;
+			}
+
+			size_t offset = 0;
+			for (size_t bucket = 0; bucket < INTERNAL::RADIX_SORT_BUCKETS; bucket++)
+			{
+				const size_t count = histogram[bucket];
+				histogram[bucket] = offset;
+				offset += count;
+			}
+
+			if (buffer == nullptr)
+			{
+				buffer = new T[length];
+			}
+			T* destination = source == data ? buffer : data;
+			for (size_t i = 0; i < length; i++)
+			{
+				destination[histogram[(extractor(source[i]) >> (digit * 8)) & 0xFF]++] = std::move(source[i]);
+			}
+			source = destination;
+		}
+
+		if (source != data)
+		{
+			for (size_t i = 0; i < length; i++)
+			{
+				data[i] = std::move(source[i]);
+			}
+		}
+		if (buffer != nullptr)
+		{
+			delete[] buffer;
+		}
+	}
+
+	template <typename T>
+	void radixSort(T* data, size_t length, bool multiThreadedHistogram = false)
+	{
+		radixSort(data, length, [](const T& t) { return radixSortKey(t); }, multiThreadedHistogram);
+	}
+
+	template <typename T, typename KeyExtractor>
+	void radixSort(List<T, false>& list, KeyExtractor extractor, bool multiThreadedHistogram = false)
+	{
+		radixSort(list.getRaw(), list.getLength(), extractor, multiThreadedHistogram);
+	}
+
+	template <typename T>
+	void radixSort(List<T, false>& list, bool multiThreadedHistogram = false)
+	{
+		radixSort(list.getRaw(), list.getLength(), multiThreadedHistogram);
+	}
+
+	template <typename T, typename KeyExtractor>
+	void radixSort(DynamicArray<T>& arr, KeyExtractor extractor, bool multiThreadedHistogram = false)
+	{
+		radixSort(arr.getRaw(), arr.getLength(), extractor, multiThreadedHistogram);
+	}
+
+	template <typename T>
+	void radixSort(DynamicArray<T>& arr, bool multiThreadedHistogram = false)
+	{
+		radixSort(arr.getRaw(), arr.getLength(), multiThreadedHistogram);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "RadixSort.h"
+#include "List.h"
+#include "DynamicArray.h"
+#include "UtilTest.h"
+#include <cstdint>
+
+namespace bbe
+{
+	namespace test
+	{
+		class RadixSortCommand
+		{
+		public:
+			uint64_t key = 0;
+			int order = 0;
+		};
+
+		void testRadixSort()
+		{
+			{
+				List<uint32_t> list;
+				List<uint32_t> expected;
+				uint32_t random = 12345;
+				for (int i = 0; i < 10000; i++)
+				{
+					random = random * 1664525 + 1013904223;
+					list.pushBack(random);
+				}
+				expected = list;
+				expected.sort();
+				radixSort(list);
+				for (size_t i = 0; i < list.getLength(); i++)
+				{
+					assertEquals(list[i], expected[i]);
+				}
+			}
+
+			{
+				List<int32_t> list;
+				list.pushBackAll(5, -3, 0, 2147483647, -2147483647 - 1, -1, 7);
+				radixSort(list);
+				assertEquals(list[0], -2147483647 - 1);
+				assertEquals(list[1], -3);
+				assertEquals(list[2], -1);
+				assertEquals(list[3], 0);
+				assertEquals(list[4], 5);
+				assertEquals(list[5], 7);
+				assertEquals(list[6], 2147483647);
+			}
+
+			{
+				List<float> list;
+				list.pushBackAll(1.5f, -0.25f, 0.0f, -100.0f, 3.0f, -1.0f, 0.125f);
+				radixSort(list);
+				assertEquals(list[0], -100.0f);
+				assertEquals(list[1], -1.0f);
+				assertEquals(list[2], -0.25f);
+				assertEquals(list[3], 0.0f);
+				assertEquals(list[4], 0.125f);
+				assertEquals(list[5], 1.5f);
+				assertEquals(list[6], 3.0f);
+			}
+
+			{
+				DynamicArray<double> arr(4);
+				arr[0] = 2.0;
+				arr[1] = -2.0;
+				arr[2] = 1e100;
+				arr[3] = -1e-100;
+				radixSort(arr);
+				assertEquals(arr[0], -2.0);
+				assertEquals(arr[1], -1e-100);
+				assertEquals(arr[2], 2.0);
+				assertEquals(arr[3], 1e100);
+			}
+
+			{
+				//Sorting by a 64 bit key is stable.
+				List<RadixSortCommand> commands;
+				for (int i = 0; i < 1000; i++)
+				{
+					RadixSortCommand command;
+					command.key = ((uint64_t)(i % 7) << 40) | (uint64_t)(i % 3);
+					command.order = i;
+					commands.pushBack(command);
+				}
+				radixSort(commands, [](const RadixSortCommand& c) { return c.key; }, true);
+				for (size_t i = 1; i < commands.getLength(); i++)
+				{
+					assertEquals(commands[i - 1].key <= commands[i].key, true);
+					if (commands[i - 1].key == commands[i].key)
+					{
+						assertEquals(commands[i - 1].order < commands[i].order, true);
+					}
+				}
+			}
+
+			{
+				List<uint64_t> list;
+				for (int i = 0; i < 300000; i++)
+				{
+					list.pushBack(((uint64_t)i * 7919) % 300000);
+				}
+				radixSort(list, true);
+				for (size_t i = 0; i < list.getLength(); i++)
+				{
+					assertEquals(list[i], i);
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
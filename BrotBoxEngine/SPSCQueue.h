@@ -0,0 +1,193 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "STLAllocator.h"
+#include "STLCapsule.h"
+#include "UtilDebug.h"
+#include "UtilMath.h"
+
+namespace bbe
+{
+	namespace INTERNAL
+	{
+		static constexpr size_t QUEUE_CACHE_LINE_SIZE = 64;
+
+		template <typename T>
+		union QueueChunk
+		{
+			//same trick as the ListChunk, T is only constructed on push
+			T value;
+
+			QueueChunk() {}
+			~QueueChunk() {}
+		};
+	}
+
+	template <typename T, typename Allocator = STLAllocator<INTERNAL::QueueChunk<T>>>
+	class SPSCQueue
+	{
+		//Bounded lock free queue for exactly one producer and one consumer thread. Head and tail
+		//live on their own cache lines, together with a cached copy of the other side's index, so
+		//the two threads only touch each others cache line when the queue seems full or empty.
+	private:
+		static constexpr size_t SPSC_QUEUE_DEFAULT_SIZE = 1024;
+
+		//Consumer side
+		alignas(INTERNAL::QUEUE_CACHE_LINE_SIZE) std::atomic<size_t> m_head;
+		size_t m_cachedTail = 0;
+
+		//Producer side
+		alignas(INTERNAL::QUEUE_CACHE_LINE_SIZE) std::atomic<size_t> m_tail;
+		size_t m_cachedHead = 0;
+
+		//Shared, read only after construction
+		alignas(INTERNAL::QUEUE_CACHE_LINE_SIZE) INTERNAL::QueueChunk<T>* m_data = nullptr;
+		size_t m_capacity;
+		size_t m_mask;
+
+		Allocator* m_parentAllocator = nullptr;
+		bool m_needsToDeleteParentAllocator = false;
+
+		template <typename U>
+		bool pushImpl(U&& value)
+		{
+			const size_t tail = m_tail.load(std::memory_order_relaxed);
+			if (tail - m_cachedHead == m_capacity)
+			{
+				m_cachedHead = m_head.load(std::memory_order_acquire);
+				if (tail - m_cachedHead == m_capacity)
+				{
+					return false;
+				}
+			}
+			new (bbe::addressOf(m_data[tail & m_mask].value)) T(std::forward<U>(value));
+			m_tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+	public:
+		explicit SPSCQueue(size_t size = SPSC_QUEUE_DEFAULT_SIZE, Allocator* parentAllocator = nullptr)
+			: m_head(0), m_tail(0), m_capacity(nextPowerOfTwo(size)), m_mask(nextPowerOfTwo(size) - 1), m_parentAllocator(parentAllocator)
+		{
+			if (m_parentAllocator == nullptr)
+			{
+				m_parentAllocator = new Allocator();
+				m_needsToDeleteParentAllocator = true;
+			}
+			m_data = m_parentAllocator->allocate(m_capacity);
+		}
+
+		SPSCQueue(const SPSCQueue&  other) = delete; //Copy Constructor
+		SPSCQueue(SPSCQueue&& other) = delete; //Move Constructor
+		SPSCQueue& operator=(const SPSCQueue&  other) = delete; //Copy Assignment
+		SPSCQueue& operator=(SPSCQueue&& other) = delete; //Move Assignment
+
+		~SPSCQueue()
+		{
+			const size_t tail = m_tail.load(std::memory_order_relaxed);
+			for (size_t i = m_head.load(std::memory_order_relaxed); i != tail; i++)
+			{
+				bbe::addressOf(m_data[i & m_mask].value)->~T();
+			}
+			if (m_data != nullptr && m_parentAllocator != nullptr)
+			{
+				m_parentAllocator->deallocate(m_data, m_capacity);
+			}
+			if (m_needsToDeleteParentAllocator)
+			{
+				delete m_parentAllocator;
+			}
+			m_data = nullptr;
+		}
+
+		bool push(const T& value)
+		{
+			return pushImpl(value);
+		}
+
+		bool push(T&& value)
+		{
+			return pushImpl(std::move(value));
+		}
+
+		size_t pushBatch(const T* values, size_t amount)
+		{
+			//Returns how many of the values were pushed. They become visible to the consumer at once.
+			const size_t tail = m_tail.load(std::memory_order_relaxed);
+			if (m_capacity - (tail - m_cachedHead) < amount)
+			{
+				m_cachedHead = m_head.load(std::memory_order_acquire);
+			}
+			const size_t freeSpace = m_capacity - (tail - m_cachedHead);
+			if (amount > freeSpace)
+			{
+				amount = freeSpace;
+			}
+			for (size_t i = 0; i < amount; i++)
+			{
+				new (bbe::addressOf(m_data[(tail + i) & m_mask].value)) T(values[i]);
+			}
+			m_tail.store(tail + amount, std::memory_order_release);
+			return amount;
+		}
+
+		bool pop(T& out)
+		{
+			const size_t head = m_head.load(std::memory_order_relaxed);
+			if (head == m_cachedTail)
+			{
+				m_cachedTail = m_tail.load(std::memory_order_acquire);
+				if (head == m_cachedTail)
+				{
+					return false;
+				}
+			}
+			T& value = m_data[head & m_mask].value;
+			out = std::move(value);
+			bbe::addressOf(value)->~T();
+			m_head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		size_t popBatch(T* out, size_t maxAmount)
+		{
+			//Returns how many values were written to out.
+			const size_t head = m_head.load(std::memory_order_relaxed);
+			if (m_cachedTail - head < maxAmount)
+			{
+				m_cachedTail = m_tail.load(std::memory_order_acquire);
+			}
+			size_t amount = m_cachedTail - head;
+			if (amount > maxAmount)
+			{
+				amount = maxAmount;
+			}
+			for (size_t i = 0; i < amount; i++)
+			{
+				T& value = m_data[(head + i) & m_mask].value;
+				out[i] = std::move(value);
+				bbe::addressOf(value)->~T();
+			}
+			m_head.store(head + amount, std::memory_order_release);
+			return amount;
+		}
+
+		size_t getCapacity() const
+		{
+			return m_capacity;
+		}
+
+		size_t getLength() const
+		{
+			//Only a snapshot if the other thread is active.
+			const size_t head = m_head.load(std::memory_order_acquire);
+			return m_tail.load(std::memory_order_acquire) - head;
+		}
+
+		bool isEmpty() const
+		{
+			return getLength() == 0;
+		}
+	};
+}
\ No newline at end of file
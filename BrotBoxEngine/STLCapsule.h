@@ -2,6 +2,9 @@
 
 #include <memory>
 #include <algorithm>
+#include <functional>
+#include <iterator>
+#include <thread>
 #include "STLAllocator.h"
 
 namespace bbe
@@ -23,4 +26,61 @@ namespace bbe
 	{
 		std::sort(start, end, pred);
 	}
+
+	namespace INTERNAL
+	{
+		template <typename RandomIterator, typename Predicate>
+		void sortParallelSTL(RandomIterator start, RandomIterator end, Predicate& pred, size_t sequentialThreshold, size_t depth)
+		{
+			const size_t length = (size_t)std::distance(start, end);
+			if (depth == 0 || length <= sequentialThreshold)
+			{
+				std::sort(start, end, pred);
+				return;
+			}
+
+			RandomIterator mid = start + length / 2;
+			std::thread leftThread(
+				[&]()
+				{
+					sortParallelSTL(start, mid, pred, sequentialThreshold, depth - 1);
+				});
+			sortParallelSTL(mid, end, pred, sequentialThreshold, depth - 1);
+			leftThread.join();
+			std::inplace_merge(start, mid, end, pred);
+		}
+	}
+
+	static constexpr size_t SORT_PARALLEL_DEFAULT_THRESHOLD = 1 << 15;
+
+	template <typename RandomIterator, typename Predicate>
+	void sortParallelSTL(RandomIterator start, RandomIterator end, Predicate pred, size_t sequentialThreshold)
+	{
+		//Parallel merge sort. The range is split in halves until there is one piece per hardware thread
+		//or a piece is not longer than sequentialThreshold. The pieces are sorted with std::sort on their
+		//own threads and merged back up pairwise. Ranges up to sequentialThreshold are sorted sequentially.
+		if (sequentialThreshold < 2)
+		{
+			sequentialThreshold = 2;
+		}
+		const size_t amountOfThreads = std::thread::hardware_concurrency();
+		size_t depth = 0;
+		while (((size_t)1 << depth) < amountOfThreads)
+		{
+			depth++;
+		}
+		INTERNAL::sortParallelSTL(start, end, pred, sequentialThreshold, depth);
+	}
+
+	template <typename RandomIterator, typename Predicate>
+	void sortParallelSTL(RandomIterator start, RandomIterator end, Predicate pred)
+	{
+		sortParallelSTL(start, end, pred, SORT_PARALLEL_DEFAULT_THRESHOLD);
+	}
+
+	template <typename RandomIterator>
+	void sortParallelSTL(RandomIterator start, RandomIterator end)
+	{
+		sortParallelSTL(start, end, std::less<typename std::iterator_traits<RandomIterator>::value_type>(), SORT_PARALLEL_DEFAULT_THRESHOLD);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include "GenerationalHandle.h"
+#include "List.h"
+#include "UtilDebug.h"
+
+namespace bbe
+{
+	typedef GenerationalHandle SlotMapHandle;
+
+	namespace INTERNAL
+	{
+		class SlotMapSlot
+		{
+		public:
+			//Index into the dense values if the slot is occupied, next free slot otherwise.
+			uint32_t m_indexOrNextFree;
+			//Incremented on every removal, so that old handles to this slot become invalid.
+			uint32_t m_generation;
+
+			SlotMapSlot(uint32_t indexOrNextFree, uint32_t generation)
+				: m_indexOrNextFree(indexOrNextFree), m_generation(generation)
+			{
+				//do nothing
+			}
+		};
+	}
+
+	template <typename T>
+	class SlotMapUniqueHandle;
+
+	template <typename T>
+	class SlotMap
+	{
+		//Stores the values densely in a List. Handles point into an indirection table of slots,
+		//which in turn point to the dense values. Removing a value moves the last value into its
+		//place, so iterating over getRaw() never has to skip holes.
+	public:
+		class SlotMapDestroyer
+		{
+		private:
+			SlotMap* m_sm;
+		public:
+			SlotMapDestroyer(SlotMap *sm)
+				: m_sm(sm)
+			{
+				//do nothing
+			}
+
+			void destroy(const SlotMapHandle& handle)
+			{
+				m_sm->remove(handle);
+			}
+
+			SlotMap* getSlotMap() const
+			{
+				return m_sm;
+			}
+		};
+
+	private:
+		static constexpr uint32_t SLOT_MAP_NO_FREE_SLOT = std::numeric_limits<uint32_t>::max();
+
+		List<T> m_values;
+		List<uint32_t> m_valueToSlot;
+		List<INTERNAL::SlotMapSlot> m_slots;
+		uint32_t m_freeHead = SLOT_MAP_NO_FREE_SLOT;
+
+	public:
+		SlotMap()
+		{
+			//do nothing
+		}
+
+		template <typename... arguments>
+		SlotMapHandle insert(arguments&&... args)
+		{
+			uint32_t slotIndex;
+			if (m_freeHead != SLOT_MAP_NO_FREE_SLOT)
+			{
+				slotIndex = m_freeHead;
+				m_freeHead = m_slots[slotIndex].m_indexOrNextFree;
+			}
+			else
+			{
+				slotIndex = (uint32_t)m_slots.getLength();
+				m_slots.pushBack(INTERNAL::SlotMapSlot(0, 0));
+			}
+
+			m_slots[slotIndex].m_indexOrNextFree = (uint32_t)m_values.getLength();
+			m_values.pushBack(T(std::forward<arguments>(args)...));
+			m_valueToSlot.pushBack(slotIndex);
+
+			return SlotMapHandle(slotIndex, m_slots[slotIndex].m_generation);
+		}
+
+		template <typename... arguments>
+		SlotMapUniqueHandle<T> insertUniqueHandle(arguments&&... args)
+		{
+			SlotMapHandle handle = insert(std::forward<arguments>(args)...);
+			return SlotMapUniqueHandle<T>(handle, SlotMapDestroyer(this));
+		}
+
+		bool contains(const SlotMapHandle& handle) const
+		{
+			return handle.m_index < m_slots.getLength() && m_slots[handle.m_index].m_generation == handle.m_generation;
+		}
+
+		T* get(const SlotMapHandle& handle)
+		{
+			if (!contains(handle))
+			{
+				return nullptr;
+			}
+			return bbe::addressOf(m_values[m_slots[handle.m_index].m_indexOrNextFree]);
+		}
+
+		const T* get(const SlotMapHandle& handle) const
+		{
+			if (!contains(handle))
+			{
+				return nullptr;
+			}
+			return bbe::addressOf(m_values[m_slots[handle.m_index].m_indexOrNextFree]);
+		}
+
+		bool remove(const SlotMapHandle& handle)
+		{
+			if (!contains(handle))
+			{
+				return false;
+			}
+
+			INTERNAL::SlotMapSlot& slot = m_slots[handle.m_index];
+			const uint32_t valueIndex = slot.m_indexOrNextFree;
+			const uint32_t lastIndex = (uint32_t)m_values.getLength() - 1;
+			if (valueIndex != lastIndex)
+			{
+				m_values[valueIndex] = std::move(m_values[lastIndex]);
+				m_valueToSlot[valueIndex] = m_valueToSlot[lastIndex];
+				m_slots[m_valueToSlot[valueIndex]].m_indexOrNextFree = valueIndex;
+			}
+			m_values.popBack();
+			m_valueToSlot.popBack();
+
+			slot.m_generation++;
+			slot.m_indexOrNextFree = m_freeHead;
+			m_freeHead = handle.m_index;
+			return true;
+		}
+
+		void clear()
+		{
+			while (m_values.getLength() > 0)
+			{
+				remove(getHandle(m_values.getLength() - 1));
+			}
+		}
+
+		SlotMapHandle getHandle(size_t valueIndex) const
+		{
+			const uint32_t slotIndex = m_valueToSlot[valueIndex];
+			return SlotMapHandle(slotIndex, m_slots[slotIndex].m_generation);
+		}
+
+		size_t getLength() const
+		{
+			return m_values.getLength();
+		}
+
+		bool isEmpty() const
+		{
+			return m_values.isEmpty();
+		}
+
+		T* getRaw()
+		{
+			return m_values.getRaw();
+		}
+
+		const T* getRaw() const
+		{
+			return m_values.getRaw();
+		}
+
+		T& operator[](size_t valueIndex)
+		{
+			return m_values[valueIndex];
+		}
+
+		const T& operator[](size_t valueIndex) const
+		{
+			return m_values[valueIndex];
+		}
+	};
+
+	template <typename T>
+	class SlotMapUniqueHandle
+	{
+		//Like the UniquePointer, but owns a value inside of a SlotMap. Values of a SlotMap move
+		//around in memory, so we have to hold the handle instead of a pointer.
+	private:
+		typedef typename SlotMap<T>::SlotMapDestroyer Destroyer;
+
+		SlotMapHandle m_handle;
+		Destroyer m_destroyer;
+
+	public:
+		explicit SlotMapUniqueHandle(const SlotMapHandle& handle, Destroyer destroyer)
+			: m_handle(handle), m_destroyer(destroyer)
+		{
+			//do nothing
+		}
+
+		~SlotMapUniqueHandle()
+		{
+			if (m_handle != SlotMapHandle())
+			{
+				m_destroyer.destroy(m_handle);
+				m_handle = SlotMapHandle();
+			}
+		}
+
+		SlotMapUniqueHandle(const SlotMapUniqueHandle& other) = delete;
+		SlotMapUniqueHandle(SlotMapUniqueHandle&& other)
+			: m_handle(other.m_handle), m_destroyer(other.m_destroyer)
+		{
+			other.m_handle = SlotMapHandle();
+		}
+		SlotMapUniqueHandle& operator= (const SlotMapUniqueHandle& other) = delete;
+		SlotMapUniqueHandle& operator= (SlotMapUniqueHandle&& other)
+		{
+			if (m_handle != SlotMapHandle())
+			{
+				m_destroyer.destroy(m_handle);
+			}
+
+			m_handle = other.m_handle;
+			m_destroyer = other.m_destroyer;
+			other.m_handle = SlotMapHandle();
+			return *this;
+		}
+
+		T* operator ->()
+		{
+			return m_destroyer.getSlotMap()->get(m_handle);
+		}
+
+		const T* operator ->() const
+		{
+			return m_destroyer.getSlotMap()->get(m_handle);
+		}
+
+		T& operator *()
+		{
+			return *m_destroyer.getSlotMap()->get(m_handle);
+		}
+
+		const T& operator *() const
+		{
+			return *m_destroyer.getSlotMap()->get(m_handle);
+		}
+
+		T* getRaw()
+		{
+			return m_destroyer.getSlotMap()->get(m_handle);
+		}
+
+		const SlotMapHandle& getHandle() const
+		{
+			return m_handle;
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "SlotMap.h"
+#include "UtilTest.h"
+
+namespace bbe
+{
+	namespace test
+	{
+		void testSlotMap()
+		{
+			{
+				SlotMap<Person> slotMap;
+				assertEquals(slotMap.getLength(), 0);
+				assertEquals(slotMap.isEmpty(), true);
+				assertEquals(slotMap.get(SlotMapHandle()), nullptr);
+
+				SlotMapHandle h1 = slotMap.insert("Name 1", "Addr 1", 1);
+				SlotMapHandle h2 = slotMap.insert("Name 2", "Addr 2", 2);
+				SlotMapHandle h3 = slotMap.insert("Name 3", "Addr 3", 3);
+				assertEquals(slotMap.getLength(), 3);
+				assertEquals(slotMap.isEmpty(), false);
+				assertEquals(slotMap.get(h1)->name, "Name 1");
+				assertEquals(slotMap.get(h2)->name, "Name 2");
+				assertEquals(slotMap.get(h3)->name, "Name 3");
+
+				assertEquals(slotMap.remove(h1), true);
+				assertEquals(slotMap.remove(h1), false);
+				assertEquals(slotMap.contains(h1), false);
+				assertEquals(slotMap.get(h1), nullptr);
+				assertEquals(slotMap.getLength(), 2);
+				assertEquals(slotMap.get(h2)->age, 2);
+				assertEquals(slotMap.get(h3)->age, 3);
+
+				//The values stay densely packed.
+				int ageSum = 0;
+				for (size_t i = 0; i < slotMap.getLength(); i++)
+				{
+					ageSum += slotMap[i].age;
+					assertEquals(slotMap.get(slotMap.getHandle(i)), slotMap.getRaw() + i);
+				}
+				assertEquals(ageSum, 5);
+
+				//The slot of h1 is reused, but the old handle must stay invalid.
+				SlotMapHandle h4 = slotMap.insert("Name 4", "Addr 4", 4);
+				assertEquals(h4.m_index, h1.m_index);
+				assertUnequals(h4, h1);
+				assertEquals(slotMap.get(h1), nullptr);
+				assertEquals(slotMap.get(h4)->name, "Name 4");
+
+				slotMap.clear();
+				assertEquals(slotMap.getLength(), 0);
+				assertEquals(slotMap.contains(h2), false);
+				assertEquals(slotMap.contains(h3), false);
+				assertEquals(slotMap.contains(h4), false);
+			}
+
+			Person::checkIfAllPersonsWereDestroyed();
+
+			{
+				SlotMap<Person> slotMap;
+				{
+					auto p1 = slotMap.insertUniqueHandle("Name 5", "Addr 5", 5);
+					auto p2 = slotMap.insertUniqueHandle("Name 6", "Addr 6", 6);
+					assertEquals(slotMap.getLength(), 2);
+					assertEquals(p1->name, "Name 5");
+					assertEquals(p2->age, 6);
+
+					auto p3(std::move(p1));
+					assertEquals(p3->name, "Name 5");
+					assertEquals(slotMap.getLength(), 2);
+				}
+				assertEquals(slotMap.getLength(), 0);
+			}
+
+			Person::checkIfAllPersonsWereDestroyed();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,337 @@
+#pragma once
+
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "DataType.h"
+#include "STLCapsule.h"
+#include "UtilDebug.h"
+#include "UtilMath.h"
+
+namespace bbe
+{
+	namespace INTERNAL
+	{
+		static constexpr size_t SOA_LIST_COLUMN_ALIGNMENT = 32;
+
+		template <typename... Ts>
+		struct SoAListMaxAlignment;
+
+		template <>
+		struct SoAListMaxAlignment<>
+		{
+			static constexpr size_t value = 1;
+		};
+
+		template <typename T, typename... Ts>
+		struct SoAListMaxAlignment<T, Ts...>
+		{
+			static constexpr size_t value = alignof(T) > SoAListMaxAlignment<Ts...>::value ? alignof(T) : SoAListMaxAlignment<Ts...>::value;
+		};
+	}
+
+	template <typename... Ts>
+	class SoAList
+	{
+		//Like a List of structs, but every member lives in its own column. All columns share one
+		//allocation, one length and one capacity, and every column starts at an address that is
+		//aligned to SOA_LIST_COLUMN_ALIGNMENT, so loops over a single column can use aligned SIMD loads.
+		static_assert(sizeof...(Ts) > 0, "A SoAList needs at least one column!");
+		static_assert(INTERNAL::SoAListMaxAlignment<Ts...>::value <= INTERNAL::SOA_LIST_COLUMN_ALIGNMENT, "Column type is over aligned!");
+	private:
+		typedef std::index_sequence_for<Ts...> Indices;
+
+		size_t m_length;
+		size_t m_capacity;
+		byte* m_allocation;
+		std::tuple<Ts*...> m_columns;
+
+		static size_t getAllocationSize(size_t capacity)
+		{
+			size_t sizes[] = { sizeof(Ts)... };
+			size_t size = INTERNAL::SOA_LIST_COLUMN_ALIGNMENT;
+			for (size_t i = 0; i < sizeof...(Ts); i++)
+			{
+				size += nextMultiple(INTERNAL::SOA_LIST_COLUMN_ALIGNMENT, sizes[i] * capacity);
+			}
+			return size;
+		}
+
+		template <size_t... Is>
+		static std::tuple<Ts*...> getColumnsOfAllocation(byte* allocation, size_t capacity, std::index_sequence<Is...>)
+		{
+			size_t sizes[] = { sizeof(Ts)... };
+			size_t offsets[sizeof...(Ts)];
+			size_t offset = nextMultiple(INTERNAL::SOA_LIST_COLUMN_ALIGNMENT, (size_t)allocation) - (size_t)allocation;
+			for (size_t i = 0; i < sizeof...(Ts); i++)
+			{
+				offsets[i] = offset;
+				offset += nextMultiple(INTERNAL::SOA_LIST_COLUMN_ALIGNMENT, sizes[i] * capacity);
+			}
+			return std::tuple<Ts*...>(reinterpret_cast<Ts*>(allocation + offsets[Is])...);
+		}
+
+		template <size_t... Is>
+		void moveColumns(std::tuple<Ts*...>& newColumns, std::index_sequence<Is...>)
+		{
+			for (size_t i = 0; i < m_length; i++)
+			{
+				int dummy[] = { 0, (new (std::get<Is>(newColumns) + i) Ts(std::move(std::get<Is>(m_columns)[i])), 0)... };
+				(void)dummy;
+			}
+			destroyRange(0, m_length, Indices());
+		}
+
+		template <size_t... Is>
+		void destroyRange(size_t from, size_t to, std::index_sequence<Is...>)
+		{
+			for (size_t i = from; i < to; i++)
+			{
+				int dummy[] = { 0, (std::get<Is>(m_columns)[i].~Ts(), 0)... };
+				(void)dummy;
+			}
+		}
+
+		template <size_t... Is>
+		void copyFrom(const SoAList& other, std::index_sequence<Is...>)
+		{
+			for (size_t i = 0; i < other.m_length; i++)
+			{
+				int dummy[] = { 0, (new (std::get<Is>(m_columns) + i) Ts(std::get<Is>(other.m_columns)[i]), 0)... };
+				(void)dummy;
+			}
+			m_length = other.m_length;
+		}
+
+		template <size_t... Is, typename... arguments>
+		void pushBackImpl(std::index_sequence<Is...>, arguments&&... args)
+		{
+			int dummy[] = { 0, (new (std::get<Is>(m_columns) + m_length) Ts(std::forward<arguments>(args)), 0)... };
+			(void)dummy;
+			m_length++;
+		}
+
+		template <size_t... Is>
+		std::tuple<Ts&...> getImpl(size_t index, std::index_sequence<Is...>)
+		{
+			return std::tuple<Ts&...>(std::get<Is>(m_columns)[index]...);
+		}
+
+		template <size_t... Is>
+		std::tuple<const Ts&...> getImpl(size_t index, std::index_sequence<Is...>) const
+		{
+			return std::tuple<const Ts&...>(std::get<Is>(m_columns)[index]...);
+		}
+
+		template <typename Func, size_t... Is>
+		void forEachImpl(Func& func, std::index_sequence<Is...>)
+		{
+			for (size_t i = 0; i < m_length; i++)
+			{
+				func(std::get<Is>(m_columns)[i]...);
+			}
+		}
+
+		void growIfNeeded(size_t amountOfNewObjects)
+		{
+			if (m_capacity < m_length + amountOfNewObjects)
+			{
+				size_t newCapacity = m_length + amountOfNewObjects;
+				if (newCapacity < m_capacity * 2)
+				{
+					newCapacity = m_capacity * 2;
+				}
+				resizeCapacity(newCapacity);
+			}
+		}
+
+		void freeAllocation()
+		{
+			destroyRange(0, m_length, Indices());
+			if (m_allocation != nullptr)
+			{
+				delete[] m_allocation;
+			}
+			m_allocation = nullptr;
+			m_columns = std::tuple<Ts*...>();
+			m_length = 0;
+			m_capacity = 0;
+		}
+
+	public:
+		SoAList()
+			: m_length(0), m_capacity(0), m_allocation(nullptr)
+		{
+			//do nothing
+		}
+
+		SoAList(const SoAList& other)
+			: m_length(0), m_capacity(0), m_allocation(nullptr)
+		{
+			resizeCapacity(other.m_length);
+			copyFrom(other, Indices());
+		}
+
+		SoAList(SoAList&& other)
+			: m_length(other.m_length), m_capacity(other.m_capacity), m_allocation(other.m_allocation), m_columns(other.m_columns)
+		{
+			other.m_length = 0;
+			other.m_capacity = 0;
+			other.m_allocation = nullptr;
+			other.m_columns = std::tuple<Ts*...>();
+		}
+
+		SoAList& operator=(const SoAList& other)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+			freeAllocation();
+			resizeCapacity(other.m_length);
+			copyFrom(other, Indices());
+			return *this;
+		}
+
+		SoAList& operator=(SoAList&& other)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+			freeAllocation();
+			m_length = other.m_length;
+			m_capacity = other.m_capacity;
+			m_allocation = other.m_allocation;
+			m_columns = other.m_columns;
+			other.m_length = 0;
+			other.m_capacity = 0;
+			other.m_allocation = nullptr;
+			other.m_columns = std::tuple<Ts*...>();
+			return *this;
+		}
+
+		~SoAList()
+		{
+			freeAllocation();
+		}
+
+		size_t getLength() const
+		{
+			return m_length;
+		}
+
+		size_t getCapacity() const
+		{
+			return m_capacity;
+		}
+
+		bool isEmpty() const
+		{
+			return m_length == 0;
+		}
+
+		template <size_t I>
+		typename std::tuple_element<I, std::tuple<Ts...>>::type* getColumn()
+		{
+			return std::get<I>(m_columns);
+		}
+
+		template <size_t I>
+		const typename std::tuple_element<I, std::tuple<Ts...>>::type* getColumn() const
+		{
+			return std::get<I>(m_columns);
+		}
+
+		std::tuple<Ts&...> get(size_t index)
+		{
+			//Zipped view of one element, usable with std::tie or std::get.
+			if (index >= m_length)
+			{
+				debugBreak();
+			}
+			return getImpl(index, Indices());
+		}
+
+		std::tuple<const Ts&...> get(size_t index) const
+		{
+			if (index >= m_length)
+			{
+				debugBreak();
+			}
+			return getImpl(index, Indices());
+		}
+
+		std::tuple<Ts&...> operator[](size_t index)
+		{
+			return get(index);
+		}
+
+		std::tuple<const Ts&...> operator[](size_t index) const
+		{
+			return get(index);
+		}
+
+		template <typename... arguments>
+		void pushBack(arguments&&... args)
+		{
+			static_assert(sizeof...(arguments) == sizeof...(Ts), "pushBack needs exactly one argument per column!");
+			growIfNeeded(1);
+			pushBackImpl(Indices(), std::forward<arguments>(args)...);
+		}
+
+		void popBack(size_t amount = 1)
+		{
+			if (amount > m_length)
+			{
+				debugBreak();
+			}
+			destroyRange(m_length - amount, m_length, Indices());
+			m_length -= amount;
+		}
+
+		void clear()
+		{
+			destroyRange(0, m_length, Indices());
+			m_length = 0;
+		}
+
+		void resizeCapacity(size_t newCapacity)
+		{
+			if (newCapacity < m_length)
+			{
+				debugBreak();
+				return;
+			}
+			if (newCapacity == m_capacity)
+			{
+				return;
+			}
+
+			byte* newAllocation = nullptr;
+			std::tuple<Ts*...> newColumns;
+			if (newCapacity > 0)
+			{
+				newAllocation = new byte[getAllocationSize(newCapacity)];
+				newColumns = getColumnsOfAllocation(newAllocation, newCapacity, Indices());
+			}
+			moveColumns(newColumns, Indices());
+
+			if (m_allocation != nullptr)
+			{
+				delete[] m_allocation;
+			}
+			m_allocation = newAllocation;
+			m_columns = newColumns;
+			m_capacity = newCapacity;
+		}
+
+		template <typename Func>
+		void forEach(Func func)
+		{
+			//Calls func(Ts&...) for every element.
+			forEachImpl(func, Indices());
+		}
+	};
+}
\ No newline at end of file
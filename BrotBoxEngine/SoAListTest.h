@@ -0,0 +1,97 @@
+#pragma once
+
+#include "SoAList.h"
+#include "UtilTest.h"
+#include <cstdint>
+
+namespace bbe
+{
+	namespace test
+	{
+		void testSoAList()
+		{
+			{
+				SoAList<float, int, Person> list;
+				assertEquals(list.getLength(), 0);
+				assertEquals(list.isEmpty(), true);
+
+				for (int i = 0; i < 100; i++)
+				{
+					list.pushBack((float)i * 0.5f, i, Person("Name", "Addr", i));
+				}
+				assertEquals(list.getLength(), 100);
+				assertEquals(list.isEmpty(), false);
+				assertEquals(list.getCapacity() >= 100, true);
+
+				assertEquals(((size_t)list.getColumn<0>()) % INTERNAL::SOA_LIST_COLUMN_ALIGNMENT, 0);
+				assertEquals(((size_t)list.getColumn<1>()) % INTERNAL::SOA_LIST_COLUMN_ALIGNMENT, 0);
+				assertEquals(((size_t)list.getColumn<2>()) % INTERNAL::SOA_LIST_COLUMN_ALIGNMENT, 0);
+
+				for (int i = 0; i < 100; i++)
+				{
+					assertEquals(list.getColumn<0>()[i], (float)i * 0.5f);
+					assertEquals(list.getColumn<1>()[i], i);
+					assertEquals(list.getColumn<2>()[i].age, i);
+				}
+
+				std::get<1>(list[10]) = 1000;
+				assertEquals(list.getColumn<1>()[10], 1000);
+
+				float f = 0;
+				int n = 0;
+				Person* p = nullptr;
+				std::tie(f, n, std::ignore) = list.get(20);
+				p = &std::get<2>(list.get(20));
+				assertEquals(f, 10.0f);
+				assertEquals(n, 20);
+				assertEquals(p->age, 20);
+
+				int sum = 0;
+				list.forEach(
+					[&](float& f, int& i, Person& p)
+					{
+						sum += p.age;
+						i++;
+					});
+				assertEquals(sum, 99 * 100 / 2);
+				assertEquals(list.getColumn<1>()[0], 1);
+
+				SoAList<float, int, Person> copy(list);
+				assertEquals(copy.getLength(), 100);
+				assertEquals(copy.getColumn<2>()[50].age, 50);
+
+				SoAList<float, int, Person> moved(std::move(copy));
+				assertEquals(copy.getLength(), 0);
+				assertEquals(moved.getLength(), 100);
+				assertEquals(moved.getColumn<2>()[99].age, 99);
+
+				moved.popBack(50);
+				assertEquals(moved.getLength(), 50);
+				copy = moved;
+				assertEquals(copy.getLength(), 50);
+				copy = std::move(list);
+				assertEquals(copy.getLength(), 100);
+				assertEquals(list.getLength(), 0);
+
+				copy.clear();
+				assertEquals(copy.getLength(), 0);
+				copy.pushBack(1.0f, 2, Person());
+				assertEquals(copy.getColumn<1>()[0], 2);
+			}
+
+			{
+				SoAList<uint8_t, double> list;
+				list.resizeCapacity(3);
+				assertEquals(list.getCapacity(), 3);
+				list.pushBack((uint8_t)1, 1.0);
+				list.pushBack((uint8_t)2, 2.0);
+				list.pushBack((uint8_t)3, 3.0);
+				list.pushBack((uint8_t)4, 4.0);
+				assertEquals(list.getCapacity(), 6);
+				assertEquals(((size_t)list.getColumn<1>()) % INTERNAL::SOA_LIST_COLUMN_ALIGNMENT, 0);
+				assertEquals(list.getColumn<0>()[3], 4);
+				assertEquals(list.getColumn<1>()[3], 4.0);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "List.h"
+#include "RadixSort.h"
+#include <cstdint>
+#include <iostream>
+#include "StopWatch.h"
+
+namespace bbe
+{
+	namespace test
+	{
+		void sortPrintScaling()
+		{
+			//Compares sort with sortParallel for growing lengths. The speedup is bounded by the
+			//final merge, which runs on a single thread.
+			while (true)
+			{
+				for (size_t length = 1000; length <= 10000000; length *= 10)
+				{
+					List<uint32_t> original;
+					uint32_t random = 12345;
+					for (size_t i = 0; i < length; i++)
+					{
+						random = random * 1664525 + 1013904223;
+						original.pushBack(random);
+					}
+
+					List<uint32_t> sequential = original;
+					StopWatch swSequential;
+					sequential.sort();
+					const long long timeSequential = swSequential.getTimeExpiredMicroseconds();
+
+					List<uint32_t> parallel = original;
+					StopWatch swParallel;
+					parallel.sortParallel();
+					const long long timeParallel = swParallel.getTimeExpiredMicroseconds();
+
+					List<uint32_t> radix = original;
+					StopWatch swRadix;
+					radixSort(radix);
+					const long long timeRadix = swRadix.getTimeExpiredMicroseconds();
+
+					std::cout << "Length: " << length << std::endl;
+					std::cout << "sort:         " << timeSequential << " us" << std::endl;
+					std::cout << "sortParallel: " << timeParallel << " us" << std::endl;
+					std::cout << "radixSort:    " << timeRadix << " us" << std::endl;
+					std::cout << "Speedup:      " << ((double)timeSequential / (timeParallel + 1)) << std::endl;
+				}
+				std::cout << std::endl;
+			}
+		}
+	}
+}
\ No newline at end of file
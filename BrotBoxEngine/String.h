@@ -1,25 +1,222 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <cwchar>
+#include <functional>
 #include "DynamicArray.h"
+#include "List.h"
+#include "ListChunk.h"
+#include "NumberConversion.h"
+#include "StringCase.h"
+#include "StringSearch.h"
+#include "StringView.h"
+#include "UtilHash.h"
 #include "Array.h"
 
 namespace bbe
 {
+	namespace INTERNAL
+	{
+		class WideCharBuffer
+		{
+			//Converts char text to wchar_t without a String. Short text is converted into a buffer on
+			//the stack, only long text needs the heap.
+		private:
+			static constexpr size_t STACK_SIZE = 128;
+			wchar_t m_stackData[STACK_SIZE];
+			wchar_t* m_heapData = nullptr;
+			size_t m_length;
+
+		public:
+			WideCharBuffer(const char* data, size_t length)
+			{
+				wchar_t* buffer = m_stackData;
+				if (length >= STACK_SIZE)
+				{
+					m_heapData = new wchar_t[length + 1];
+					buffer = m_heapData;
+				}
+				mbstowcs_s(0, buffer, length + 1, data, length);
+				m_length = wcslen(buffer);
+			}
+
+			explicit WideCharBuffer(const char* data)
+				: WideCharBuffer(data, strlen(data))
+			{
+				//do nothing
+			}
+
+			WideCharBuffer(const WideCharBuffer& other) = delete;
+			WideCharBuffer& operator=(const WideCharBuffer& other) = delete;
+
+			~WideCharBuffer()
+			{
+				if (m_heapData != nullptr)
+				{
+					delete[] m_heapData;
+				}
+			}
+
+			StringView getView() const
+			{
+				return StringView(m_heapData != nullptr ? m_heapData : m_stackData, m_length);
+			}
+		};
+	}
+
 	class String
 	{
-#define SSOSIZE (16)
 		//TODO use allocators
+	public:
+		//Amount of characters, without the terminating 0, that are stored inside the String itself:
+		//15 with the 2 byte wchar_t of Windows, 7 with the 4 byte wchar_t of Linux.
+		static constexpr size_t SSO_CAPACITY = 32 / sizeof(wchar_t) - 1;
+
 	private:
-		union
+		//Short and long strings share the same 32 bytes. A short string uses all of them for its characters.
+		//The last character slot holds SSO_CAPACITY - length, so it becomes the terminating 0 exactly when
+		//the storage is full. A long string keeps its data pointer, length and cached hash at the start and
+		//its capacity in the last word. The highest bit of that word marks a long string, it is always 0 in
+		//the last slot of a short string. The second highest bit tells if m_hash is valid, short strings do
+		//not cache their hash. The third highest bit is set once the non const getRaw or operator[] handed
+		//out the buffer, see getHash. This relies on a little endian layout.
+		//Compared to the old separate flag, length and capacity, a String shrinks from 64 to 32 bytes on
+		//Windows x64 (48 to 32 on Win32) and still holds 15 characters inline. With the 4 byte wchar_t of
+		//Linux it shrinks from 96 to 32 bytes, but only 7 instead of 15 characters fit inline, so strings of
+		//8 to 15 characters allocate there. Every access to the length or the characters has to check the
+		//flag first.
+		static constexpr size_t STORAGE_WORDS = 32 / sizeof(size_t);
+		static constexpr size_t LONG_FLAG = (size_t)1 << (sizeof(size_t) * 8 - 1);
+		static constexpr size_t HASH_FLAG = (size_t)1 << (sizeof(size_t) * 8 - 2);
+		static constexpr size_t HANDED_OUT_FLAG = (size_t)1 << (sizeof(size_t) * 8 - 3);
+
+		struct LongData
 		{
 			wchar_t *m_data;
-			wchar_t m_ssoData[SSOSIZE];
+			size_t m_length;
+			mutable size_t m_hash;
 		};
-		bool m_usesSSO = true;
-		size_t m_length = 0;
-		size_t m_capacity;
+
+		union
+		{
+			LongData m_long;
+			wchar_t m_shortData[SSO_CAPACITY + 1];
+			mutable size_t m_words[STORAGE_WORDS];
+		};
+
+		static wchar_t* allocateChars(size_t amount)
+		{
+			//Heap buffers are ListChunk arrays, so that they can be exchanged with Lists and DynamicArrays.
+			return reinterpret_cast<wchar_t*>(new INTERNAL::ListChunk<wchar_t>[amount]);
+		}
+
+		static void freeChars(wchar_t* data)
+		{
+			delete[] reinterpret_cast<INTERNAL::ListChunk<wchar_t>*>(data);
+		}
+
+		bool isLong() const
+		{
+			//Only looks at the last character slot, which a short string always sets. Of a long string, it
+			//holds the highest bits of the capacity word.
+			return ((uint32_t)m_shortData[SSO_CAPACITY] >> (sizeof(wchar_t) * 8 - 1)) != 0;
+		}
+
+		void setShort(size_t length)
+		{
+			//The terminating 0 is written separately, unless length == SSO_CAPACITY.
+			m_shortData[SSO_CAPACITY] = (wchar_t)(SSO_CAPACITY - length);
+		}
+
+		void setLong(wchar_t *data, size_t length, size_t capacity)
+		{
+			m_long.m_data = data;
+			m_long.m_length = length;
+			m_words[STORAGE_WORDS - 1] = capacity | LONG_FLAG;
+		}
+
+		void setLength(size_t length)
+		{
+			if (isLong())
+			{
+				m_long.m_length = length;
+			}
+			else
+			{
+				setShort(length);
+			}
+		}
+
+		void setEmpty()
+		{
+			setShort(0);
+			m_shortData[0] = 0;
+		}
+
+		wchar_t* getRawForWriting()
+		{
+			//For the modifications of String itself. They are done before the next getHash, so forgetting
+			//the cached hash is enough.
+			if (isLong())
+			{
+				m_words[STORAGE_WORDS - 1] &= ~HASH_FLAG;
+				return m_long.m_data;
+			}
+			return m_shortData;
+		}
+
+		void freeLong()
+		{
+			if (isLong())
+			{
+				freeChars(m_long.m_data);
+				setEmpty();
+			}
+		}
+
+		void initialize(const wchar_t *data, size_t length)
+		{
+			if (length <= SSO_CAPACITY)
+			{
+				wmemcpy(m_shortData, data, length);
+				m_shortData[length] = 0;
+				setShort(length);
+			}
+			else
+			{
+				wchar_t *newData = allocateChars(length + 1);
+				wmemcpy(newData, data, length);
+				newData[length] = 0;
+				setLong(newData, length, length + 1);
+			}
+		}
+
+		void initializeFromCharArr(const char *data, size_t length)
+		{
+			//length counts bytes. Multibyte characters convert to fewer wchar_ts, so the length of the String
+			//is taken from the converted text, like in WideCharBuffer.
+			if (length <= SSO_CAPACITY)
+			{
+				mbstowcs_s(0, m_shortData, length + 1, data, length);
+				setShort(wcslen(m_shortData));
+			}
+			else
+			{
+				wchar_t *newData = allocateChars(length + 1);
+				mbstowcs_s(0, newData, length + 1, data, length);
+				setLong(newData, wcslen(newData), length + 1);
+			}
+		}
+
+		void copyHash(const String& other)
+		{
+			if (isLong() && other.isLong() && (other.m_words[STORAGE_WORDS - 1] & HASH_FLAG) != 0)
+			{
+				m_long.m_hash = other.m_long.m_hash;
+				m_words[STORAGE_WORDS - 1] |= HASH_FLAG;
+			}
+		}
 
 		void growIfNeeded(size_t newSize) {
 			if (getCapacity() < newSize) {
@@ -27,283 +224,292 @@ namespace bbe
 				if (newCapa < getCapacity() * 2) {
 					newCapa = getCapacity() * 2;
 				}
-				wchar_t *newData = new wchar_t[newCapa];
-				wmemcpy(newData, getRaw(), getCapacity());
+				const size_t length = getLength();
+				wchar_t *newData = allocateChars(newCapa);
+				wmemcpy(newData, getRawForWriting(), length + 1);
 
-				if (!m_usesSSO) {
-					delete[] m_data;
+				if (isLong()) {
+					freeChars(m_long.m_data);
 				}
 
-				m_usesSSO = false;
-				m_capacity = newCapa;
-				m_data = newData;
+				setLong(newData, length, newCapa);
 			}
 		}
 
-		void initializeFromWCharArr(const wchar_t *data)
+		void append(const wchar_t* data, size_t length)
 		{
-			//PO
-			m_data = nullptr;
-			m_capacity = 0;
+			//data may point into this String, e.g. for s += s.
+			const size_t oldLength = getLength();
+			const wchar_t* raw = getRawForWriting();
+			const bool aliases = !std::less<const wchar_t*>()(data, raw) && std::less<const wchar_t*>()(data, raw + oldLength);
+			const size_t offset = data - raw;
+			growIfNeeded(oldLength + length + 1);
+			if (aliases)
+			{
+				data = getRawForWriting() + offset;
+			}
+			wchar_t* newRaw = getRawForWriting();
+			wmemcpy(newRaw + oldLength, data, length);
+			newRaw[oldLength + length] = 0;
+			setLength(oldLength + length);
+		}
 
-			if (m_length == 0)
+		const wchar_t* find(const wchar_t* start, const StringView& needle) const
+		{
+			//Returns the first occurrence of needle at or after start, or nullptr if there is none or
+			//needle is empty.
+			if (needle.isEmpty())
 			{
-				m_length = wcslen(data);
+				return nullptr;
 			}
-			
-			if (m_length < SSOSIZE)
+			return stringSearch(start, getRaw() + getLength() - start, needle.getRaw(), needle.getLength());
+		}
+
+		const wchar_t* skipWhitespace() const
+		{
+			const wchar_t* position = getRaw();
+			while (INTERNAL::stringIsWhitespace(*position))
 			{
-				wmemcpy(m_ssoData, data, m_length + 1);
-				m_usesSSO = true;
-				m_capacity = SSOSIZE;
+				position++;
 			}
-			else
+			return position;
+		}
+
+		NumberParseError checkWholeStringParsed(const NumberParseResult<wchar_t>& result) const
+		{
+			if (result.error == NumberParseError::NONE && result.end != getRaw() + getLength())
 			{
-				m_data = new wchar_t[m_length + 1];
-				wmemcpy(m_data, data, m_length + 1);
-				m_usesSSO = false;
-				m_capacity = m_length + 1;
+				return NumberParseError::INVALID_ARGUMENT;
 			}
+			return result.error;
 		}
 
-		void initializeFromCharArr(const char *data)
+		static String concat(const StringView& a, const StringView& b)
 		{
 			//PO
-			m_data = nullptr;
-			m_capacity = 0;
+			size_t totalLength = a.getLength() + b.getLength();
+			String retVal;
 
-			if (m_length == 0)
-			{
-				m_length = strlen(data);
-			}
-			
-			if (m_length < SSOSIZE)
+			if (totalLength <= SSO_CAPACITY)
 			{
-				mbstowcs_s(0, m_ssoData, m_length + 1, data, m_length);
-				m_usesSSO = true;
-				m_capacity = SSOSIZE;
+				memcpy(retVal.m_shortData, a.getRaw(), sizeof(wchar_t) * a.getLength());
+				memcpy(retVal.m_shortData + a.getLength(), b.getRaw(), sizeof(wchar_t) * b.getLength());
+				retVal.m_shortData[totalLength] = 0;
+				retVal.setShort(totalLength);
 			}
 			else
 			{
-				m_data = new wchar_t[m_length + 1];
-				mbstowcs_s(0, m_data, m_length + 1, data, m_length);
-				m_usesSSO = false;
-				m_capacity = m_length + 1;
+				wchar_t *newData = allocateChars(totalLength + 1);
+				memcpy(newData, a.getRaw(), sizeof(wchar_t) * a.getLength());
+				memcpy(newData + a.getLength(), b.getRaw(), sizeof(wchar_t) * b.getLength());
+				newData[totalLength] = 0;
+
+				retVal.setLong(newData, totalLength, totalLength + 1);
 			}
-			
+			return retVal;
 		}
 
 	public:
 		String()
 		{
-			initializeFromWCharArr(L"");
+			setEmpty();
 		}
 
 		template<int size>
 		String(const Array<wchar_t, size>& arr)
 		{
 			//UNTESTED
-			initializeFromWCharArr(arr.getRaw());
+			initialize(arr.getRaw(), wcslen(arr.getRaw()));
 		}
 
 		String(const DynamicArray<wchar_t>& arr)
 		{
 			//UNTESTED
-			initializeFromWCharArr(arr.getRaw());
+			initialize(arr.getRaw(), wcslen(arr.getRaw()));
+		}
+
+		String(DynamicArray<wchar_t>&& arr)
+			: String(arr.release())
+		{
+			//do nothing
+		}
+
+		explicit String(const StringView& view)
+		{
+			initialize(view.getRaw(), view.getLength());
+		}
+
+		String(ListBuffer<wchar_t>&& buffer)
+		{
+			setEmpty();
+			adopt(std::move(buffer));
 		}
 
 		template<int size>
 		String(const Array<char, size>& arr)
 		{
 			//UNTESTED
-			initializeFromCharArr(arr.getRaw());
+			initializeFromCharArr(arr.getRaw(), strlen(arr.getRaw()));
 		}
 
 		String(const DynamicArray<char>& arr)
 		{
 			//UNTESTED
-			initializeFromCharArr(arr.getRaw());
+			initializeFromCharArr(arr.getRaw(), strlen(arr.getRaw()));
 		}
 
 		String(const wchar_t *data)
 		{
 			//PO
-			initializeFromWCharArr(data);
+			initialize(data, wcslen(data));
 		}
 
 		String(const char* data)
 		{
-			initializeFromCharArr(data);
+			initializeFromCharArr(data, strlen(data));
 		}
 
 		String(const std::string &data)
 		{
-			m_length = data.length();
-			initializeFromCharArr(data.c_str());
+			initializeFromCharArr(data.c_str(), data.length());
 		}
 
 		String(const std::wstring &data)
 		{
-			m_length = data.length();
-			initializeFromWCharArr(data.c_str());
+			initialize(data.c_str(), data.length());
 		}
 
 		String(double number)
+			: String(INTERNAL::NumberBuffer(number).getView())
 		{
-			initializeFromCharArr(std::to_string(number).c_str());
+			//do nothing
 		}
 
 		String(int number)
+			: String(INTERNAL::NumberBuffer(number).getView())
 		{
-			initializeFromCharArr(std::to_string(number).c_str());
+			//do nothing
 		}
 
 		String(long long number)
+			: String(INTERNAL::NumberBuffer(number).getView())
 		{
-			initializeFromCharArr(std::to_string(number).c_str());
+			//do nothing
 		}
 
 		String(long double number)
+			: String(INTERNAL::NumberBuffer(number).getView())
 		{
-			initializeFromCharArr(std::to_string(number).c_str());
+			//do nothing
 		}
 
 		String(float number)
+			: String(INTERNAL::NumberBuffer(number).getView())
 		{
-			initializeFromCharArr(std::to_string(number).c_str());
+			//do nothing
 		}
 
 		String(unsigned long long number)
+			: String(INTERNAL::NumberBuffer(number).getView())
 		{
-			initializeFromCharArr(std::to_string(number).c_str());
+			//do nothing
 		}
 
 		String(unsigned long number)
+			: String(INTERNAL::NumberBuffer(number).getView())
 		{
-			initializeFromCharArr(std::to_string(number).c_str());
+			//do nothing
 		}
 
 		String(long number)
+			: String(INTERNAL::NumberBuffer(number).getView())
 		{
-			initializeFromCharArr(std::to_string(number).c_str());
+			//do nothing
 		}
 
 		String(unsigned int number)
+			: String(INTERNAL::NumberBuffer(number).getView())
 		{
-			initializeFromCharArr(std::to_string(number).c_str());
+			//do nothing
 		}
 
 		String(const String&  other)//Copy Constructor
 		{ 
-			m_length = other.getLength();
-			if (other.m_usesSSO)
-			{
-				initializeFromWCharArr(other.m_ssoData);
-			}
-			else
-			{
-				initializeFromWCharArr(other.m_data);
-			}
+			initialize(other.getRaw(), other.getLength());
+			copyHash(other);
 		}
 
 		String(String&& other) //Move Constructor
 		{
-			m_length = other.m_length;
-			m_usesSSO = other.m_usesSSO;
-			if (other.m_usesSSO)
-			{
-				wmemcpy(m_ssoData, other.m_ssoData, SSOSIZE);
-				m_capacity = SSOSIZE;
-			}
-			else
-			{
-				m_data = other.m_data;
-				m_capacity = other.m_capacity;
-				other.m_data = nullptr;
-			}
-			other.m_length = 0;
+			memcpy(m_shortData, other.m_shortData, sizeof(m_shortData));
+			other.setEmpty();
 		}
 
 		String& operator=(const String&  other) //Copy Assignment
 		{ 
-			if (!m_usesSSO && m_data != nullptr)
-			{
-				delete[] m_data;
-			}
-
-			m_length = other.getLength();
-			if (other.m_usesSSO)
-			{
-				initializeFromWCharArr(other.m_ssoData);
-			}
-			else
+			if (this == &other)
 			{
-				initializeFromWCharArr(other.m_data);
+				return *this;
 			}
+			freeLong();
+			initialize(other.getRaw(), other.getLength());
+			copyHash(other);
 			return *this;
 		}
 
 		String& operator=(String&& other)//Move Assignment
 		{ 
-			if (!m_usesSSO && m_data != nullptr)
-			{
-				delete[] m_data;
-			}
-			
-			m_length = other.m_length;
-			m_usesSSO = other.m_usesSSO;
-
-			if (other.m_usesSSO)
-			{
-				wmemcpy(m_ssoData, other.m_ssoData, SSOSIZE);
-				m_capacity = SSOSIZE;
-			}
-			else
+			if (this == &other)
 			{
-				m_capacity = other.m_capacity;
-				m_data = other.m_data;
+				return *this;
 			}
-			
-			other.m_data = nullptr;
-			other.m_length = 0;
+			freeLong();
+			memcpy(m_shortData, other.m_shortData, sizeof(m_shortData));
+			other.setEmpty();
 			return *this;
 		}
 
 		~String()
 		{
-			if (!m_usesSSO && m_data != nullptr)
-			{
-				delete[] m_data;
-				m_data = nullptr;
-			}
+			freeLong();
+		}
+
+		operator StringView() const
+		{
+			return StringView(getRaw(), getLength());
+		}
+
+		bool operator==(const StringView& view) const
+		{
+			const size_t length = getLength();
+			return length == view.getLength() && wmemcmp(getRaw(), view.getRaw(), length) == 0;
 		}
 
 		bool operator==(const String& other) const
 		{
-			return wcscmp(getRaw(), other.getRaw()) == 0;
+			return operator==(StringView(other));
 		}
 
 		bool operator==(const wchar_t* arr) const
 		{
-			return wcscmp(getRaw(), arr) == 0;
+			return operator==(StringView(arr));
 		}
 
 		bool operator==(const char* arr) const
 		{
-			String localString(arr);
-			return operator==(localString);
+			INTERNAL::WideCharBuffer buffer(arr);
+			return operator==(buffer.getView());
 		}
 
 		bool operator==(const std::string& str) const
 		{
-			String localString(str);
-			return operator==(localString);
+			INTERNAL::WideCharBuffer buffer(str.c_str(), str.length());
+			return operator==(buffer.getView());
 		}
 
 		bool operator==(const std::wstring& str) const
 		{
-			String localString(str);
-			return operator==(localString);
+			return operator==(StringView(str));
 		}
 
 		friend bool operator==(const wchar_t* arr, const String& a)
@@ -326,6 +532,11 @@ namespace bbe
 			return a.operator==(str);
 		}
 
+		bool operator!=(const StringView& view) const
+		{
+			return !operator==(view);
+		}
+
 		bool operator!=(const String& other) const
 		{
 			return !operator==(other);
@@ -376,422 +587,413 @@ namespace bbe
 			return string.operator!=(str);
 		}
 
-		String operator+(const String& other) const
+		String operator+(const StringView& other) const
 		{
-			//PO
-			size_t totalLength = m_length + other.m_length;
-			String retVal;
-			retVal.m_length = totalLength;
-
-			if (totalLength < SSOSIZE)
-			{
-				memcpy(retVal.m_ssoData, getRaw(), sizeof(wchar_t) * m_length);
-				memcpy(retVal.m_ssoData + m_length, other.getRaw(), sizeof(wchar_t) * other.m_length);
-				retVal.m_ssoData[totalLength] = 0;
-			}
-			else
-			{
-				wchar_t *newData = new wchar_t[totalLength + 1];
-				memcpy(newData, getRaw(), sizeof(wchar_t) * m_length);
-				memcpy(newData + m_length, other.getRaw(), sizeof(wchar_t) * other.m_length);
-				newData[totalLength] = 0;
+			return concat(*this, other);
+		}
 
-				retVal.m_usesSSO = false;
-				retVal.m_data = newData;
-			}
-			return retVal;
+		String operator+(const String& other) const
+		{
+			return concat(*this, other);
 		}
 
 		String operator+(const std::string& other) const
 		{
-			return operator+(String(other));
+			INTERNAL::WideCharBuffer buffer(other.c_str(), other.length());
+			return concat(*this, buffer.getView());
 		}
 
 		String operator+(const std::wstring& other) const
 		{
-			return operator+(String(other));
+			return concat(*this, other);
 		}
 
 		String operator+(const wchar_t* other) const
 		{
-			return operator+(String(other));
+			return concat(*this, other);
 		}
 
 		String operator+(const char* other) const
 		{
-			return operator+(String(other));
+			INTERNAL::WideCharBuffer buffer(other);
+			return concat(*this, buffer.getView());
 		}
 
 		String operator+(double number) const
 		{
-			return operator+(String(number));
+			return operator+(INTERNAL::NumberBuffer(number).getView());
 		}
 
 		String operator+(int number) const
 		{
-			return operator+(String(number));
+			return operator+(INTERNAL::NumberBuffer(number).getView());
 		}
 
 		String operator+(long long number) const
 		{
-			return operator+(String(number));
+			return operator+(INTERNAL::NumberBuffer(number).getView());
 		}
 
 		String operator+(long double number) const
 		{
-			return operator+(String(number));
+			return operator+(INTERNAL::NumberBuffer(number).getView());
 		}
 
 		String operator+(float number) const
 		{
-			return operator+(String(number));
+			return operator+(INTERNAL::NumberBuffer(number).getView());
 		}
 
 		String operator+(unsigned long long number) const
 		{
-			return operator+(String(number));
+			return operator+(INTERNAL::NumberBuffer(number).getView());
 		}
 
 		String operator+(unsigned long number) const
 		{
-			return operator+(String(number));
+			return operator+(INTERNAL::NumberBuffer(number).getView());
 		}
 
 		String operator+(long number) const
 		{
-			return operator+(String(number));
+			return operator+(INTERNAL::NumberBuffer(number).getView());
 		}
 
 		String operator+(unsigned int number) const
 		{
-			return operator+(String(number));
+			return operator+(INTERNAL::NumberBuffer(number).getView());
+		}
+
+		friend String operator+(const StringView& other, const String& string)
+		{
+			return concat(other, string);
 		}
 
 		friend String operator+(const std::string& other, const String& string)
 		{
-			return String(other) + string;
+			INTERNAL::WideCharBuffer buffer(other.c_str(), other.length());
+			return concat(buffer.getView(), string);
 		}
 
 		friend String operator+(const std::wstring& other, const String& string)
 		{
-			return String(other) + string;
+			return concat(other, string);
 		}
 
 		friend String operator+(const wchar_t* other, const String& string)
 		{
-			return String(other) + string;
+			return concat(other, string);
 		}
 
 		friend String operator+(const char* other, const String& string)
 		{
-			return String(other) + string;
+			INTERNAL::WideCharBuffer buffer(other);
+			return concat(buffer.getView(), string);
 		}
 
 		friend String operator+(double number, const String& string)
 		{
-			return String(number) + string;
+			return concat(INTERNAL::NumberBuffer(number).getView(), string);
 		}
 
 		friend String operator+(int number, const String& string)
 		{
-			return String(number) + string;
+			return concat(INTERNAL::NumberBuffer(number).getView(), string);
 		}
 
 		friend String operator+(long long number, const String& string)
 		{
-			return String(number) + string;
+			return concat(INTERNAL::NumberBuffer(number).getView(), string);
 		}
 
 		friend String operator+(long double number, const String& string)
 		{
-			return String(number) + string;
+			return concat(INTERNAL::NumberBuffer(number).getView(), string);
 		}
 
 		friend String operator+(float number, const String& string)
 		{
-			return String(number) + string;
+			return concat(INTERNAL::NumberBuffer(number).getView(), string);
 		}
 
 		friend String operator+(unsigned long long number, const String& string)
 		{
-			return String(number) + string;
+			return concat(INTERNAL::NumberBuffer(number).getView(), string);
 		}
 
 		friend String operator+(unsigned long number, const String& string)
 		{
-			return String(number) + string;
+			return concat(INTERNAL::NumberBuffer(number).getView(), string);
 		}
 
 		friend String operator+(long number, const String& string)
 		{
-			return String(number) + string;
+			return concat(INTERNAL::NumberBuffer(number).getView(), string);
 		}
 
 		friend String operator+(unsigned int number, const String& string)
 		{
-			return String(number) + string;
+			return concat(INTERNAL::NumberBuffer(number).getView(), string);
 		}
 
-		String& operator+=(const String& other)
+		String& operator+=(const StringView& other)
 		{
-			size_t totalLength = m_length + other.m_length;
-			size_t oldLength = m_length;
-			m_length = totalLength;
+			append(other.getRaw(), other.getLength());
+			return *this;
+		}
 
-			if (totalLength < SSOSIZE) {
-				memcpy(m_ssoData + oldLength, other.getRaw(), sizeof(wchar_t) * other.m_length);
-				m_ssoData[totalLength] = 0;
-			}
-			else {
-				growIfNeeded(totalLength + 1);
-				memcpy(getRaw() + oldLength, other.getRaw(), sizeof(wchar_t) * other.m_length);
-				m_data[totalLength] = 0;
-			}
+		String& operator+=(const String& other)
+		{
+			append(other.getRaw(), other.getLength());
 			return *this;
 		}
 
 		String& operator+=(const std::string& other)
 		{
-			return operator+=(bbe::String(other));
+			INTERNAL::WideCharBuffer buffer(other.c_str(), other.length());
+			return operator+=(buffer.getView());
 		}
 
 		String& operator+=(const std::wstring& other)
 		{
-			return operator+=(bbe::String(other));
+			append(other.c_str(), other.length());
+			return *this;
 		}
 
 		String& operator+=(const wchar_t* other)
 		{
-			return operator+=(bbe::String(other));
+			append(other, wcslen(other));
+			return *this;
 		}
 
 		String& operator+=(const char* other)
 		{
-			return operator+=(bbe::String(other));
+			INTERNAL::WideCharBuffer buffer(other);
+			return operator+=(buffer.getView());
 		}
 
 		String& operator+=(double number)
 		{
-			return operator+=(bbe::String(number));
+			return operator+=(INTERNAL::NumberBuffer(number).getView());
 		}
 
 		String& operator+=(int number)
 		{
-			return operator+=(bbe::String(number));
+			return operator+=(INTERNAL::NumberBuffer(number).getView());
 		}
 
 		String& operator+=(long long number)
 		{
-			return operator+=(bbe::String(number));
+			return operator+=(INTERNAL::NumberBuffer(number).getView());
 		}
 
 		String& operator+=(long double number)
 		{
-			return operator+=(bbe::String(number));
+			return operator+=(INTERNAL::NumberBuffer(number).getView());
 		}
 
 		String& operator+=(float number)
 		{
-			return operator+=(bbe::String(number));
+			return operator+=(INTERNAL::NumberBuffer(number).getView());
 		}
 
 		String& operator+=(unsigned long long number)
 		{
-			return operator+=(bbe::String(number));
+			return operator+=(INTERNAL::NumberBuffer(number).getView());
 		}
 
 		String& operator+=(unsigned long number)
 		{
-			return operator+=(bbe::String(number));
+			return operator+=(INTERNAL::NumberBuffer(number).getView());
 		}
 
 		String& operator+=(long number)
 		{
-			return operator+=(bbe::String(number));
+			return operator+=(INTERNAL::NumberBuffer(number).getView());
 		}
 
 		String& operator+=(unsigned int number)
 		{
-			return operator+=(bbe::String(number));
+			return operator+=(INTERNAL::NumberBuffer(number).getView());
 		}
 
 		void trim()
 		{
+			auto raw = getRawForWriting();
+			const size_t length = getLength();
 			size_t start = 0;
-			size_t end = m_length - 1;
-			auto raw = getRaw();
-
-			while (iswspace(raw[start]))
+			size_t end = length;
+			while (start < end && INTERNAL::stringIsWhitespace(raw[start]))
 			{
 				start++;
 			}
-			while (iswspace(raw[end]) && end != 0)
+			while (end > start && INTERNAL::stringIsWhitespace(raw[end - 1]))
 			{
 				end--;
 			}
 
-			if (start != 0 || end != m_length)
+			if (start != 0 || end != length)
 			{
-				if (end == 0) //Special Case, if the string only contains whitespace
-				{ 
-					m_length = 0;
-					raw[m_length] = 0;
-				}
-				else
-				{
-					m_length = end - start + 1;
-					memmove(raw, &raw[start], sizeof(wchar_t) * m_length);
-					raw[m_length] = 0;
-				}
+				const size_t newLength = end - start;
+				wmemmove(raw, raw + start, newLength);
+				raw[newLength] = 0;
+				setLength(newLength);
 			}
 		}
 
-		size_t count(const String& countand) const
+		size_t count(const StringView& countand) const
 		{
-			size_t countandLength = countand.getLength();
-			if (countandLength == 0)
-			{
-				return 0;
-			}
 			size_t amount = 0;
 			const wchar_t *readHead = getRaw();
 
-			while ((readHead = wcsstr(readHead, countand.getRaw())) != nullptr)
+			while ((readHead = find(readHead, countand)) != nullptr)
 			{
 				amount++;
-				readHead += countandLength;
+				readHead += countand.getLength();
 			}
 			return amount;
 		}
 
+		size_t count(const String& countand) const
+		{
+			return count(StringView(countand));
+		}
+
 		size_t count(const wchar_t* countand) const
 		{
-			return count(String(countand));
+			return count(StringView(countand));
 		}
 
-		size_t count(char* countand) const
+		size_t count(const char* countand) const
 		{
-			return count(String(countand));
+			INTERNAL::WideCharBuffer buffer(countand);
+			return count(buffer.getView());
 		}
 
-		size_t count(std::string countand) const
+		size_t count(const std::string& countand) const
 		{
-			return count(String(countand));
+			INTERNAL::WideCharBuffer buffer(countand.c_str(), countand.length());
+			return count(buffer.getView());
 		}
 
-		size_t count(std::wstring countand) const
+		size_t count(const std::wstring& countand) const
 		{
-			return count(String(countand));
+			return count(StringView(countand));
 		}
 
-		DynamicArray<String> split(const String& splitAt) const
+		DynamicArray<String> split(const StringView& splitAt) const
 		{
-			//TODO this method is a little mess. Clean it up!
-			size_t counted = count(splitAt);
-			if (counted == 0)
+			//Searches the string only once. The pieces are collected in a List whose buffer is then
+			//adopted by the DynamicArray. Short pieces use the SSO storage.
+			List<String> pieces;
+			for (const StringView& piece : splitView(splitAt))
 			{
-				DynamicArray<String> retVal(1);
-				retVal[0] = getRaw();
-				return retVal;
-			}
-			DynamicArray<String> retVal(counted + 1);
-			const wchar_t *previousFinding = getRaw();
-			for (size_t i = 0; i < retVal.getLength() - 1; i++)
-			{
-				const wchar_t *currentFinding = wcsstr(previousFinding, splitAt.getRaw());
-				String currentString;
-				size_t currentStringLength = currentFinding - previousFinding;
-				currentString.m_usesSSO = false; //TODO make this better! current string could use SSO!
-				currentString.m_data = new wchar_t[currentStringLength + 1];
-				memcpy(currentString.m_data, previousFinding, currentStringLength * sizeof(wchar_t));
-				currentString.m_data[currentStringLength] = 0;
-				currentString.m_length = currentStringLength;
-
-				retVal[i] = currentString;
-
-				previousFinding = currentFinding + splitAt.getLength();
+				pieces.pushBack(String(piece));
 			}
+			return DynamicArray<String>(pieces.release());
+		}
 
-			String currentString;
-			size_t currentStringLength = m_data + m_length - previousFinding;
-			currentString.m_usesSSO = false; //TODO make this better! current string could use SSO!
-			currentString.m_data = new wchar_t[currentStringLength + 1];
-			memcpy(currentString.m_data, previousFinding, currentStringLength * sizeof(wchar_t));
-			currentString.m_data[currentStringLength] = 0;
-			currentString.m_length = currentStringLength;
-			retVal[retVal.getLength() - 1] = currentString;
+		StringViewSplitRange splitView(const StringView& splitAt) const
+		{
+			//Lazy, allocation free split. The pieces point into this string, so it must neither be
+			//modified nor destroyed while the range or its pieces are used. The same holds for splitAt.
+			return StringView(*this).splitView(splitAt);
+		}
 
-			return retVal;
+		DynamicArray<String> split(const String& splitAt) const
+		{
+			return split(StringView(splitAt));
 		}
 
 		DynamicArray<String> split(const wchar_t* splitAt) const
 		{
-			return split(String(splitAt));
+			return split(StringView(splitAt));
 		}
 
 		DynamicArray<String> split(const char* splitAt) const
 		{
-			return split(String(splitAt));
+			INTERNAL::WideCharBuffer buffer(splitAt);
+			return split(buffer.getView());
 		}
 
-		DynamicArray<String> split(std::string splitAt) const
+		DynamicArray<String> split(const std::string& splitAt) const
 		{
-			return split(String(splitAt));
+			INTERNAL::WideCharBuffer buffer(splitAt.c_str(), splitAt.length());
+			return split(buffer.getView());
 		}
 
-		DynamicArray<String> split(std::wstring splitAt) const
+		DynamicArray<String> split(const std::wstring& splitAt) const
 		{
-			return split(String(splitAt));
+			return split(StringView(splitAt));
 		}
 
 		bool contains(const wchar_t* string) const
 		{
-			return contains(String(string));
+			return contains(StringView(string));
 		}
 
 		bool contains(const char* string) const
 		{
-			return contains(String(string));
+			INTERNAL::WideCharBuffer buffer(string);
+			return contains(buffer.getView());
 		}
 
 		bool contains(const std::string& string) const
 		{
-			return contains(String(string));
+			INTERNAL::WideCharBuffer buffer(string.c_str(), string.length());
+			return contains(buffer.getView());
 		}
 
 		bool contains(const std::wstring& string) const
 		{
-			return contains(String(string));
+			return contains(StringView(string));
 		}
 
 		bool contains(const String& string) const
 		{
-			return wcsstr(getRaw(), string.getRaw()) != nullptr;
+			return contains(StringView(string));
+		}
+
+		bool contains(const StringView& string) const
+		{
+			return search(string) >= 0;
 		}
 
 		int64_t search(const wchar_t* string) const
 		{
-			return search(String(string));
+			return search(StringView(string));
 		}
 
 		int64_t search(const char* string) const
 		{
-			return search(String(string));
+			INTERNAL::WideCharBuffer buffer(string);
+			return search(buffer.getView());
 		}
 
 		int64_t search(const std::string& string) const
 		{
-			return search(String(string));
+			INTERNAL::WideCharBuffer buffer(string.c_str(), string.length());
+			return search(buffer.getView());
 		}
 
 		int64_t search(const std::wstring& string) const
 		{
-			return search(String(string));
+			return search(StringView(string));
 		}
 
 		int64_t search(const String& string) const
 		{
-			const wchar_t *found = wcsstr(getRaw(), string.getRaw());
+			return search(StringView(string));
+		}
+
+		int64_t search(const StringView& string) const
+		{
+			//The empty string is found at 0, like wcsstr does.
+			if (string.isEmpty())
+			{
+				return 0;
+			}
+			const wchar_t *found = find(getRaw(), string);
 			if (found == nullptr)
 			{
 				return -1;
@@ -800,19 +1002,52 @@ namespace bbe
 			return found - getRaw();
 		}
 
-		long toLong(int base = 10)
+		long toLong(int base = 10) const
 		{
-			return wcstol(getRaw(), nullptr, base);
+			//Like wcstol, but independent of the locale. Leading whitespace is skipped, text after the
+			//number is ignored and 0 is returned if there is no number.
+			long long value = 0;
+			bbe::parseNumber(skipWhitespace(), getRaw() + getLength(), value, base);
+			if (value > LONG_MAX)
+			{
+				return LONG_MAX;
+			}
+			if (value < LONG_MIN)
+			{
+				return LONG_MIN;
+			}
+			return (long)value;
+		}
+
+		double toDouble() const
+		{
+			double value = 0;
+			bbe::parseNumber(skipWhitespace(), getRaw() + getLength(), value);
+			return value;
 		}
 
-		double toDouble()
+		float toFloat() const
 		{
-			return wcstod(getRaw(), nullptr);
+			float value = 0;
+			bbe::parseNumber(skipWhitespace(), getRaw() + getLength(), value);
+			return value;
 		}
 
-		float toFloat()
+		NumberParseError parseNumber(long long& out, int base = 10) const
 		{
-			return wcstof(getRaw(), nullptr);
+			//Unlike toLong, the whole String has to be the number. out is only changed on success or,
+			//clamped, on OUT_OF_RANGE.
+			return checkWholeStringParsed(bbe::parseNumber(getRaw(), getRaw() + getLength(), out, base));
+		}
+
+		NumberParseError parseNumber(double& out) const
+		{
+			return checkWholeStringParsed(bbe::parseNumber(getRaw(), getRaw() + getLength(), out));
+		}
+
+		NumberParseError parseNumber(float& out) const
+		{
+			return checkWholeStringParsed(bbe::parseNumber(getRaw(), getRaw() + getLength(), out));
 		}
 
 		wchar_t& operator[](size_t index)
@@ -827,54 +1062,127 @@ namespace bbe
 
 		wchar_t* getRaw()
 		{
-			if (m_usesSSO)
+			//The characters may be changed through the pointer at any later time, also after the next
+			//getHash. So the buffer stops caching its hash until it is replaced.
+			if (isLong())
 			{
-				return m_ssoData;
+				m_words[STORAGE_WORDS - 1] = (m_words[STORAGE_WORDS - 1] & ~HASH_FLAG) | HANDED_OUT_FLAG;
+				return m_long.m_data;
 			}
 			else
 			{
-				return m_data;
+				return m_shortData;
 			}
 		}
 
 		const wchar_t* getRaw() const
 		{
-			if (m_usesSSO)
+			if (isLong())
 			{
-				return m_ssoData;
+				return m_long.m_data;
 			}
 			else
 			{
-				return m_data;
+				return m_shortData;
 			}
 		}
 
 		void toUpperCase()
 		{
-			auto raw = getRaw();
-			for (size_t i = 0; i < m_length; i++)
+			stringToUpperCase(getRawForWriting(), getLength());
+		}
+
+		void toLowerCase()
+		{
+			stringToLowerCase(getRawForWriting(), getLength());
+		}
+
+		size_t getLength() const
+		{
+			if (isLong())
 			{
-				raw[i] = towupper(raw[i]);
+				return m_long.m_length;
 			}
+			return SSO_CAPACITY - m_shortData[SSO_CAPACITY];
 		}
 
-		void toLowerCase()
+		size_t getCapacity() const
 		{
-			auto raw = getRaw();
-			for (size_t i = 0; i < m_length; i++)
+			if (isLong())
 			{
-				raw[i] = towlower(raw[i]);
+				return m_words[STORAGE_WORDS - 1] & ~(LONG_FLAG | HASH_FLAG | HANDED_OUT_FLAG);
 			}
+			return SSO_CAPACITY + 1;
 		}
 
-		size_t getLength() const
+		size_t getHash() const
 		{
-			return m_length;
+			//Computed on first use and kept until the String is modified. A long String whose buffer was handed
+			//out by the non const getRaw() or operator[] is not cached, because the characters may still be
+			//written through that pointer or reference. Like everything else in String this is not
+			//synchronized, a String that is hashed by several threads at once has to be hashed once beforehand.
+			if (!isLong())
+			{
+				return (size_t)hashBytes(m_shortData, getLength() * sizeof(wchar_t));
+			}
+			const size_t flags = m_words[STORAGE_WORDS - 1];
+			if ((flags & HANDED_OUT_FLAG) != 0)
+			{
+				return (size_t)hashBytes(m_long.m_data, m_long.m_length * sizeof(wchar_t));
+			}
+			if ((flags & HASH_FLAG) == 0)
+			{
+				m_long.m_hash = (size_t)hashBytes(m_long.m_data, m_long.m_length * sizeof(wchar_t));
+				m_words[STORAGE_WORDS - 1] |= HASH_FLAG;
+			}
+			return m_long.m_hash;
 		}
 
-		size_t getCapacity() const
+		ListBuffer<wchar_t> release()
 		{
-			return m_capacity;
+			//Hands the characters over as a buffer of getLength() characters, followed by the terminating 0.
+			//Only short strings are copied, as they live inside the String. The String is empty afterwards.
+			const size_t length = getLength();
+			INTERNAL::ListChunk<wchar_t>* data;
+			size_t capacity;
+			if (isLong())
+			{
+				data = reinterpret_cast<INTERNAL::ListChunk<wchar_t>*>(m_long.m_data);
+				capacity = getCapacity();
+			}
+			else
+			{
+				wchar_t* copy = allocateChars(length + 1);
+				wmemcpy(copy, m_shortData, length + 1);
+				data = reinterpret_cast<INTERNAL::ListChunk<wchar_t>*>(copy);
+				capacity = length + 1;
+			}
+			ListBuffer<wchar_t> retVal(data, length, capacity);
+			setEmpty();
+			return retVal;
+		}
+
+		void adopt(ListBuffer<wchar_t>&& buffer)
+		{
+			//The String ends at the first 0 of the buffer or at its end. The buffer is taken over without
+			//copying, unless the String fits into the String itself or there is no room left for the 0.
+			const wchar_t* data = buffer.getRaw();
+			const wchar_t* terminator = buffer.getLength() > 0 ? wmemchr(data, 0, buffer.getLength()) : nullptr;
+			const size_t length = terminator != nullptr ? terminator - data : buffer.getLength();
+
+			freeLong();
+
+			if (length <= SSO_CAPACITY || length == buffer.getCapacity())
+			{
+				initialize(data, length);
+			}
+			else
+			{
+				const size_t capacity = buffer.getCapacity();
+				wchar_t* newData = reinterpret_cast<wchar_t*>(buffer.takeData());
+				newData[length] = 0;
+				setLong(newData, length, capacity);
+			}
 		}
 	};
 
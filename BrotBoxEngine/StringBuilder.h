@@ -0,0 +1,389 @@
+#pragma once
+
+#include <cwchar>
+#include <functional>
+#include <string>
+#include "List.h"
+#include "ListChunk.h"
+#include "NumberConversion.h"
+#include "String.h"
+#include "StringView.h"
+
+namespace bbe
+{
+	namespace INTERNAL
+	{
+		struct StringBuilderChunk
+		{
+			ListChunk<wchar_t>* m_data;
+			size_t m_length;
+			size_t m_capacity;
+		};
+	}
+
+	class StringBuilder
+	{
+		//Collects text in a list of chunks. A full chunk is never copied or reallocated, the next one
+		//simply starts where it ended, so appending is linear in the total length. Numbers are formatted
+		//directly into the chunks instead of going through a temporary String.
+		//Very large outputs do not have to be merged into one String at all, forEachChunk hands out the
+		//chunks one after another, e.g. to write them to a file.
+	private:
+		static constexpr size_t MIN_CHUNK_SIZE = 64;
+		static constexpr size_t MAX_CHUNK_SIZE = 1024 * 1024;
+
+		List<INTERNAL::StringBuilderChunk> m_chunks;
+		size_t m_length = 0;
+		size_t m_capacity = 0;
+		//Free part of the last chunk. Its m_length is only updated when the next chunk is added.
+		wchar_t* m_writePosition = nullptr;
+		wchar_t* m_writeEnd = nullptr;
+
+		void addChunk(size_t minimumCapacity)
+		{
+			//Every chunk is as large as all previous ones together, up to MAX_CHUNK_SIZE.
+			size_t capacity = m_capacity;
+			if (capacity < MIN_CHUNK_SIZE)
+			{
+				capacity = MIN_CHUNK_SIZE;
+			}
+			if (capacity > MAX_CHUNK_SIZE)
+			{
+				capacity = MAX_CHUNK_SIZE;
+			}
+			if (capacity < minimumCapacity)
+			{
+				capacity = minimumCapacity;
+			}
+			if (!m_chunks.isEmpty())
+			{
+				m_chunks.last().m_length = getChunkLength(m_chunks.getLength() - 1);
+			}
+			INTERNAL::StringBuilderChunk chunk;
+			chunk.m_data = new INTERNAL::ListChunk<wchar_t>[capacity];
+			chunk.m_length = 0;
+			chunk.m_capacity = capacity;
+			m_chunks.pushBack(chunk);
+			m_capacity += capacity;
+			m_writePosition = reinterpret_cast<wchar_t*>(chunk.m_data);
+			m_writeEnd = m_writePosition + capacity;
+		}
+
+		size_t getChunkLength(size_t index) const
+		{
+			const INTERNAL::StringBuilderChunk& chunk = m_chunks[index];
+			if (index + 1 == m_chunks.getLength())
+			{
+				return m_writePosition - reinterpret_cast<const wchar_t*>(chunk.m_data);
+			}
+			return chunk.m_length;
+		}
+
+		void appendRaw(const wchar_t* data, size_t length)
+		{
+			if ((size_t)(m_writeEnd - m_writePosition) >= length)
+			{
+				wmemcpy(m_writePosition, data, length);
+				m_writePosition += length;
+				m_length += length;
+				return;
+			}
+			while (length > 0)
+			{
+				size_t free = m_writeEnd - m_writePosition;
+				if (free == 0)
+				{
+					addChunk(length);
+					free = m_writeEnd - m_writePosition;
+				}
+				const size_t amount = length < free ? length : free;
+				wmemcpy(m_writePosition, data, amount);
+				m_writePosition += amount;
+				m_length += amount;
+				data += amount;
+				length -= amount;
+			}
+		}
+
+		template <typename Number>
+		void appendNumber(Number number)
+		{
+			//Formats straight into the chunk. The few characters left at the end of a full chunk stay unused.
+			if ((size_t)(m_writeEnd - m_writePosition) < NUMBER_FORMAT_MAX_LENGTH)
+			{
+				addChunk(NUMBER_FORMAT_MAX_LENGTH);
+			}
+			const size_t length = formatNumber(number, m_writePosition);
+			m_writePosition += length;
+			m_length += length;
+		}
+
+		ListBuffer<wchar_t> copyToBuffer() const
+		{
+			ListBuffer<wchar_t> buffer(new INTERNAL::ListChunk<wchar_t>[m_length + 1], m_length, m_length + 1);
+			wchar_t* position = buffer.getRaw();
+			forEachChunk([&position](const StringView& chunk)
+			{
+				wmemcpy(position, chunk.getRaw(), chunk.getLength());
+				position += chunk.getLength();
+			});
+			return buffer;
+		}
+
+		void freeChunks()
+		{
+			for (size_t i = 0; i < m_chunks.getLength(); i++)
+			{
+				delete[] m_chunks[i].m_data;
+			}
+			m_chunks.clear();
+			m_length = 0;
+			m_capacity = 0;
+			m_writePosition = nullptr;
+			m_writeEnd = nullptr;
+		}
+
+	public:
+		StringBuilder()
+		{
+			//do nothing
+		}
+
+		explicit StringBuilder(size_t capacity)
+		{
+			reserve(capacity);
+		}
+
+		StringBuilder(const StringBuilder& other) = delete;
+		StringBuilder& operator=(const StringBuilder& other) = delete;
+
+		StringBuilder(StringBuilder&& other)
+			: m_chunks(std::move(other.m_chunks)), m_length(other.m_length), m_capacity(other.m_capacity),
+			m_writePosition(other.m_writePosition), m_writeEnd(other.m_writeEnd)
+		{
+			other.m_length = 0;
+			other.m_capacity = 0;
+			other.m_writePosition = nullptr;
+			other.m_writeEnd = nullptr;
+		}
+
+		StringBuilder& operator=(StringBuilder&& other)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+			freeChunks();
+			m_chunks = std::move(other.m_chunks);
+			m_length = other.m_length;
+			m_capacity = other.m_capacity;
+			m_writePosition = other.m_writePosition;
+			m_writeEnd = other.m_writeEnd;
+			other.m_length = 0;
+			other.m_capacity = 0;
+			other.m_writePosition = nullptr;
+			other.m_writeEnd = nullptr;
+			return *this;
+		}
+
+		~StringBuilder()
+		{
+			freeChunks();
+		}
+
+		void reserve(size_t amount)
+		{
+			//The next amount characters are appended without an allocation.
+			if ((size_t)(m_writeEnd - m_writePosition) >= amount)
+			{
+				return;
+			}
+			if (!m_chunks.isEmpty() && getChunkLength(m_chunks.getLength() - 1) == 0)
+			{
+				m_capacity -= m_chunks.last().m_capacity;
+				delete[] m_chunks.last().m_data;
+				m_chunks.popBack();
+				m_writePosition = nullptr;
+				m_writeEnd = nullptr;
+				if (!m_chunks.isEmpty())
+				{
+					wchar_t* data = reinterpret_cast<wchar_t*>(m_chunks.last().m_data);
+					m_writePosition = data + m_chunks.last().m_length;
+					m_writeEnd = data + m_chunks.last().m_capacity;
+				}
+			}
+			addChunk(amount);
+		}
+
+		size_t getLength() const
+		{
+			return m_length;
+		}
+
+		bool isEmpty() const
+		{
+			return m_length == 0;
+		}
+
+		void clear()
+		{
+			//Keeps the first chunk for reuse.
+			if (m_chunks.isEmpty())
+			{
+				return;
+			}
+			INTERNAL::StringBuilderChunk first = m_chunks[0];
+			for (size_t i = 1; i < m_chunks.getLength(); i++)
+			{
+				delete[] m_chunks[i].m_data;
+			}
+			m_chunks.clear();
+			first.m_length = 0;
+			m_chunks.pushBack(first);
+			m_length = 0;
+			m_capacity = first.m_capacity;
+			m_writePosition = reinterpret_cast<wchar_t*>(first.m_data);
+			m_writeEnd = m_writePosition + first.m_capacity;
+		}
+
+		StringBuilder& append(const StringView& text)
+		{
+			appendRaw(text.getRaw(), text.getLength());
+			return *this;
+		}
+
+		StringBuilder& append(const String& text)
+		{
+			appendRaw(text.getRaw(), text.getLength());
+			return *this;
+		}
+
+		StringBuilder& append(const wchar_t* text)
+		{
+			appendRaw(text, wcslen(text));
+			return *this;
+		}
+
+		StringBuilder& append(const std::wstring& text)
+		{
+			appendRaw(text.c_str(), text.length());
+			return *this;
+		}
+
+		StringBuilder& append(const char* text)
+		{
+			INTERNAL::WideCharBuffer buffer(text);
+			return append(buffer.getView());
+		}
+
+		StringBuilder& append(const std::string& text)
+		{
+			INTERNAL::WideCharBuffer buffer(text.c_str(), text.length());
+			return append(buffer.getView());
+		}
+
+		StringBuilder& append(wchar_t character)
+		{
+			appendRaw(&character, 1);
+			return *this;
+		}
+
+		StringBuilder& append(int number)
+		{
+			appendNumber((long long)number);
+			return *this;
+		}
+
+		StringBuilder& append(long number)
+		{
+			appendNumber((long long)number);
+			return *this;
+		}
+
+		StringBuilder& append(long long number)
+		{
+			appendNumber(number);
+			return *this;
+		}
+
+		StringBuilder& append(unsigned int number)
+		{
+			appendNumber((unsigned long long)number);
+			return *this;
+		}
+
+		StringBuilder& append(unsigned long number)
+		{
+			appendNumber((unsigned long long)number);
+			return *this;
+		}
+
+		StringBuilder& append(unsigned long long number)
+		{
+			appendNumber(number);
+			return *this;
+		}
+
+		StringBuilder& append(float number)
+		{
+			appendNumber(number);
+			return *this;
+		}
+
+		StringBuilder& append(double number)
+		{
+			appendNumber(number);
+			return *this;
+		}
+
+		StringBuilder& append(long double number)
+		{
+			appendNumber((double)number);
+			return *this;
+		}
+
+		template <typename T>
+		StringBuilder& operator+=(const T& value)
+		{
+			return append(value);
+		}
+
+		void forEachChunk(std::function<void(const StringView&)> callback) const
+		{
+			for (size_t i = 0; i < m_chunks.getLength(); i++)
+			{
+				const size_t length = getChunkLength(i);
+				if (length > 0)
+				{
+					callback(StringView(reinterpret_cast<const wchar_t*>(m_chunks[i].m_data), length));
+				}
+			}
+		}
+
+		String toString() const
+		{
+			//Copies the text, the builder keeps it.
+			return String(copyToBuffer());
+		}
+
+		ListBuffer<wchar_t> release()
+		{
+			//Hands the text over to a String and empties the builder. If it still fits into one chunk with
+			//room for the terminating 0, the chunk is handed over without copying:
+			//    String text = builder.release();
+			if (m_chunks.getLength() == 1 && m_length < m_chunks[0].m_capacity)
+			{
+				ListBuffer<wchar_t> buffer(m_chunks[0].m_data, m_length, m_chunks[0].m_capacity);
+				m_chunks.clear();
+				m_length = 0;
+				m_capacity = 0;
+				m_writePosition = nullptr;
+				m_writeEnd = nullptr;
+				return buffer;
+			}
+			ListBuffer<wchar_t> buffer = copyToBuffer();
+			freeChunks();
+			return buffer;
+		}
+	};
+}
\ No newline at end of file
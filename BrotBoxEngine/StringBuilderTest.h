@@ -0,0 +1,110 @@
+#pragma once
+
+#include <climits>
+#include "String.h"
+#include "StringBuilder.h"
+#include "UtilTest.h"
+
+namespace bbe
+{
+	namespace test
+	{
+		void testStringBuilder()
+		{
+			{
+				StringBuilder builder;
+				assertEquals(builder.isEmpty(), true);
+				assertEquals(builder.toString(), "");
+				builder.append("Hallo").append(L' ').append(L"Welt ").append(String("und ")).append(std::string("alle")).append(std::wstring(L"!"));
+				assertEquals(builder.getLength(), 20);
+				assertEquals(builder.toString(), "Hallo Welt und alle!");
+
+				builder.clear();
+				assertEquals(builder.getLength(), 0);
+				builder += 42;
+				builder += L' ';
+				builder += -17;
+				builder += " ";
+				builder += 0u;
+				builder += " ";
+				builder += LLONG_MIN;
+				builder += " ";
+				builder += ULLONG_MAX;
+				assertEquals(builder.toString(), "42 -17 0 -9223372036854775808 18446744073709551615");
+			}
+
+			{
+				//Numbers look the same as when they are added to a String.
+				StringBuilder builder;
+				builder.append(2839.192).append(L' ').append(1.5f).append(L' ').append(-0.25).append(L' ').append(1e300);
+				String expected = String(2839.192) + " " + String(1.5f) + " " + String(-0.25) + " " + String(1e300);
+				assertEquals(builder.toString(), expected);
+			}
+
+			{
+				//Many appends end up in several chunks, which are merged by toString.
+				StringBuilder builder;
+				String expected;
+				for (int i = 0; i < 20000; i++)
+				{
+					builder += i;
+					builder += ",";
+					expected += i;
+					expected += ",";
+				}
+				assertEquals(builder.getLength(), expected.getLength());
+				assertEquals(builder.toString(), expected);
+
+				size_t amountOfChunks = 0;
+				size_t length = 0;
+				builder.forEachChunk([&](const StringView& chunk)
+				{
+					assertEquals(StringView(expected.getRaw() + length, chunk.getLength()), chunk);
+					length += chunk.getLength();
+					amountOfChunks++;
+				});
+				assertEquals(length, expected.getLength());
+				assertEquals(amountOfChunks > 1, true);
+
+				String released = builder.release();
+				assertEquals(released, expected);
+				assertEquals(builder.getLength(), 0);
+				builder += "again";
+				assertEquals(builder.toString(), "again");
+			}
+
+			{
+				//A reserved builder hands its only chunk over to the String without copying.
+				StringBuilder builder(1000);
+				for (int i = 0; i < 100; i++)
+				{
+					builder += "0123456789";
+				}
+				assertEquals(builder.getLength(), 1000);
+				builder.reserve(1);
+				builder += L'!';
+				String text = builder.release();
+				assertEquals(text.getLength(), 1001);
+				assertEquals(text[1000], L'!');
+
+				StringBuilder exact(20);
+				exact += "A text of twenty ch.";
+				String copy = exact.toString();
+				String released = exact.release();
+				assertEquals(copy, released);
+				assertEquals(released.getLength(), 20);
+
+				StringBuilder chained;
+				chained += "first chunk";
+				chained.reserve(1000);
+				chained.reserve(2000);
+				chained += " second chunk";
+				assertEquals(chained.toString(), "first chunk second chunk");
+
+				StringBuilder moved(std::move(exact));
+				moved += "x";
+				assertEquals(moved.toString(), "x");
+			}
+		}
+	}
+}
\ No newline at end of file
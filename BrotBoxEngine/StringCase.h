@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <cwchar>
+#include <cwctype>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define BBE_STRING_CASE_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace bbe
+{
+	namespace INTERNAL
+	{
+		//ASCII characters are handled without towupper, towlower and iswspace, which look up the locale for
+		//every character. They are treated the same in every locale, all other characters still go through
+		//the wide char functions.
+
+		inline bool stringCaseIsAscii(wchar_t c)
+		{
+			return (uint32_t)c < 0x80;
+		}
+
+		inline wchar_t stringCaseToUpper(wchar_t c)
+		{
+			if (stringCaseIsAscii(c))
+			{
+				return (c >= L'a' && c <= L'z') ? (wchar_t)(c - (L'a' - L'A')) : c;
+			}
+			return (wchar_t)towupper(c);
+		}
+
+		inline wchar_t stringCaseToLower(wchar_t c)
+		{
+			if (stringCaseIsAscii(c))
+			{
+				return (c >= L'A' && c <= L'Z') ? (wchar_t)(c + (L'a' - L'A')) : c;
+			}
+			return (wchar_t)towlower(c);
+		}
+
+		inline bool stringIsWhitespace(wchar_t c)
+		{
+			if (stringCaseIsAscii(c))
+			{
+				return c == L' ' || (c >= L'\t' && c <= L'\r');
+			}
+			return iswspace(c) != 0;
+		}
+
+		template <bool toUpper>
+		inline void stringConvertCase(wchar_t* data, size_t length)
+		{
+			size_t i = 0;
+#ifdef BBE_STRING_CASE_USE_SSE2
+			//Works on the bytes of 16 byte blocks, so it does not care about the size of wchar_t. In a block of
+			//ASCII characters all bytes but the lowest one of each character are 0, so a letter is a byte in
+			//the range of the letters and flipping its 0x20 bit changes the case. Blocks that contain other
+			//characters are converted one by one.
+			const size_t charsPerBlock = sizeof(__m128i) / sizeof(wchar_t);
+			const __m128i nonAsciiBits = sizeof(wchar_t) == 2 ? _mm_set1_epi16((short)0xFF80) : _mm_set1_epi32((int)0xFFFFFF80);
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i beforeFirst = _mm_set1_epi8((char)(toUpper ? 'a' - 1 : 'A' - 1));
+			const __m128i afterLast = _mm_set1_epi8((char)(toUpper ? 'z' + 1 : 'Z' + 1));
+			const __m128i caseBit = _mm_set1_epi8(0x20);
+			for (; i + charsPerBlock <= length; i += charsPerBlock)
+			{
+				__m128i* position = reinterpret_cast<__m128i*>(data + i);
+				const __m128i block = _mm_loadu_si128(position);
+				if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(block, nonAsciiBits), zero)) != 0xFFFF)
+				{
+					for (size_t k = i; k < i + charsPerBlock; k++)
+					{
+						data[k] = toUpper ? stringCaseToUpper(data[k]) : stringCaseToLower(data[k]);
+					}
+					continue;
+				}
+				const __m128i isLetter = _mm_and_si128(_mm_cmpgt_epi8(block, beforeFirst), _mm_cmplt_epi8(block, afterLast));
+				_mm_storeu_si128(position, _mm_xor_si128(block, _mm_and_si128(isLetter, caseBit)));
+			}
+#endif
+			for (; i < length; i++)
+			{
+				data[i] = toUpper ? stringCaseToUpper(data[i]) : stringCaseToLower(data[i]);
+			}
+		}
+	}
+
+	inline void stringToUpperCase(wchar_t* data, size_t length)
+	{
+		INTERNAL::stringConvertCase<true>(data, length);
+	}
+
+	inline void stringToLowerCase(wchar_t* data, size_t length)
+	{
+		INTERNAL::stringConvertCase<false>(data, length);
+	}
+}
\ No newline at end of file
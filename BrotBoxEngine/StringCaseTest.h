@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cwchar>
+#include "List.h"
+#include "String.h"
+#include "StringCase.h"
+#include "UtilTest.h"
+
+namespace bbe
+{
+	namespace test
+	{
+		void testStringCase()
+		{
+			{
+				String mixed("Assets/Textures/Brick_Wall 01.PNG");
+				mixed.toLowerCase();
+				assertEquals(mixed, "assets/textures/brick_wall 01.png");
+				mixed.toUpperCase();
+				assertEquals(mixed, "ASSETS/TEXTURES/BRICK_WALL 01.PNG");
+
+				String empty;
+				empty.toUpperCase();
+				assertEquals(empty, "");
+			}
+
+			{
+				//The characters around the letters must stay unchanged.
+				String borders(L"@AZ[`az{\x7F");
+				borders.toLowerCase();
+				assertEquals(borders, L"@az[`az{\x7F");
+				borders.toUpperCase();
+				assertEquals(borders, L"@AZ[`AZ{\x7F");
+			}
+
+			{
+				//Every length and position of a non ASCII character, so that blocks and the tail are covered.
+				for (size_t length = 0; length < 40; length++)
+				{
+					for (size_t special = 0; special <= length; special++)
+					{
+						List<wchar_t> text;
+						for (size_t i = 0; i < length; i++)
+						{
+							const wchar_t c = i == special ? (wchar_t)0xE4 : (wchar_t)(L'a' + (i % 26));
+							text.pushBack(c);
+						}
+						stringToUpperCase(text.getRaw(), text.getLength());
+						for (size_t i = 0; i < length; i++)
+						{
+							const wchar_t c = i == special ? (wchar_t)0xE4 : (wchar_t)(L'a' + (i % 26));
+							assertEquals(text[i], i == special ? (wchar_t)towupper(c) : (wchar_t)(L'A' + (i % 26)));
+						}
+						stringToLowerCase(text.getRaw(), text.getLength());
+						for (size_t i = 0; i < length; i++)
+						{
+							const wchar_t c = i == special ? (wchar_t)0xE4 : (wchar_t)(L'a' + (i % 26));
+							assertEquals(text[i], i == special ? (wchar_t)towlower(towupper(c)) : c);
+						}
+					}
+				}
+			}
+
+			{
+				assertEquals(INTERNAL::stringIsWhitespace(L' '), true);
+				assertEquals(INTERNAL::stringIsWhitespace(L'\t'), true);
+				assertEquals(INTERNAL::stringIsWhitespace(L'\r'), true);
+				assertEquals(INTERNAL::stringIsWhitespace(L'\x1F'), false);
+				assertEquals(INTERNAL::stringIsWhitespace(L'a'), false);
+				assertEquals(INTERNAL::stringIsWhitespace(0), false);
+			}
+		}
+	}
+}
\ No newline at end of file
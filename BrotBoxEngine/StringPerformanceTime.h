@@ -5,6 +5,7 @@
 #include "UtilTest.h"
 #include "CPUWatch.h"
 #include "String.h"
+#include "StringBuilder.h"
 #include <string>
 #include <vector>
 
@@ -16,6 +17,11 @@ namespace bbe {
 
 		void stringSpeedAddition() {
 			double total = 0;
+			double totalBuilder = 0;
+			double totalNumbers = 0;
+			double totalBuilderNumbers = 0;
+			double totalShortNumbers = 0;
+			double totalBuilderShortNumbers = 0;
 			int numRuns = 0;
 			while (true) {
 				CPUWatch allocationWatch;
@@ -24,13 +30,62 @@ namespace bbe {
 				for (int i = 0; i < 10000000; i++) {
 					a += b;
 				}
-
 				total += allocationWatch.getTimeExpiredSeconds();
+
+				CPUWatch builderWatch;
+				bbe::StringBuilder builder;
+				builder += L"Hallo ";
+				for (int i = 0; i < 10000000; i++) {
+					builder += b;
+				}
+				bbe::String built = builder.release();
+				totalBuilder += builderWatch.getTimeExpiredSeconds();
+
+				CPUWatch numbersWatch;
+				bbe::String numbers;
+				for (int i = 0; i < 10000000; i++) {
+					numbers += i;
+				}
+				totalNumbers += numbersWatch.getTimeExpiredSeconds();
+
+				CPUWatch builderNumbersWatch;
+				bbe::StringBuilder numberBuilder;
+				for (int i = 0; i < 10000000; i++) {
+					numberBuilder += i;
+				}
+				bbe::String builtNumbers = numberBuilder.release();
+				totalBuilderNumbers += builderNumbersWatch.getTimeExpiredSeconds();
+
+				//Many short texts, e.g. one line per entity, 20000 texts of 1000 numbers each.
+				CPUWatch shortNumbersWatch;
+				size_t shortLength = 0;
+				for (int k = 0; k < 20000; k++) {
+					bbe::String shortNumbers;
+					for (int i = 0; i < 1000; i++) {
+						shortNumbers += i;
+					}
+					shortLength += shortNumbers.getLength();
+				}
+				totalShortNumbers += shortNumbersWatch.getTimeExpiredSeconds();
+
+				CPUWatch builderShortNumbersWatch;
+				size_t builderShortLength = 0;
+				for (int k = 0; k < 20000; k++) {
+					bbe::StringBuilder shortNumberBuilder;
+					for (int i = 0; i < 1000; i++) {
+						shortNumberBuilder += i;
+					}
+					bbe::String builtShortNumbers = shortNumberBuilder.release();
+					builderShortLength += builtShortNumbers.getLength();
+				}
+				totalBuilderShortNumbers += builderShortNumbersWatch.getTimeExpiredSeconds();
 				numRuns++;
 
 
 
-				std::cout << total/numRuns << std::endl;
+				std::cout << "String: " << total / numRuns << " StringBuilder: " << totalBuilder / numRuns << std::endl;
+				std::cout << "String numbers: " << totalNumbers / numRuns << " StringBuilder numbers: " << totalBuilderNumbers / numRuns << std::endl;
+				std::cout << "String short numbers: " << totalShortNumbers / numRuns << " StringBuilder short numbers: " << totalBuilderShortNumbers / numRuns << " " << shortLength << " " << builderShortLength << std::endl;
 			}
 		}
 
@@ -53,5 +108,75 @@ namespace bbe {
 			}
 
 		}
+
+		void stringSearchSpeed() {
+			//A multi-MB log, searched for a rare word, counted and split into lines.
+			bbe::String log;
+			for (int i = 0; i < 100000; i++) {
+				log += L"INFO 2017-03-14 worker thread finished job without errors\n";
+			}
+			log += L"ERROR worker thread crashed\n";
+			while (true) {
+				CPUWatch wcsstrWatch;
+				const wchar_t* found = wcsstr(log.getRaw(), L"ERROR");
+				double wcsstrTime = wcsstrWatch.getTimeExpiredSeconds();
+
+				CPUWatch searchWatch;
+				int64_t index = log.search(L"ERROR");
+				double searchTime = searchWatch.getTimeExpiredSeconds();
+
+				CPUWatch countWatch;
+				size_t lines = log.count(L"\n");
+				double countTime = countWatch.getTimeExpiredSeconds();
+
+				CPUWatch splitWatch;
+				bbe::DynamicArray<bbe::String> pieces = log.split(L"\n");
+				double splitTime = splitWatch.getTimeExpiredSeconds();
+
+				CPUWatch splitViewWatch;
+				size_t longestLine = 0;
+				for (const bbe::StringView& line : log.splitView(L"\n")) {
+					if (line.getLength() > longestLine) {
+						longestLine = line.getLength();
+					}
+				}
+				double splitViewTime = splitViewWatch.getTimeExpiredSeconds();
+
+				std::cout << "wcsstr: " << wcsstrTime << " search: " << searchTime << " count: " << countTime << " split: " << splitTime << " splitView: " << splitViewTime << std::endl;
+				std::cout << (found - log.getRaw()) << " " << index << " " << lines << " " << pieces.getLength() << " " << longestLine << std::endl;
+			}
+		}
+
+		void stringCaseSpeed() {
+			//Asset paths are normalized to lower case for every lookup.
+			bbe::List<bbe::String> paths;
+			for (int i = 0; i < 100000; i++) {
+				paths.pushBack(bbe::String(L"Assets/Textures/Environment/Brick_Wall_") + i + L".PNG");
+			}
+			while (true) {
+				CPUWatch towlowerWatch;
+				for (size_t i = 0; i < paths.getLength(); i++) {
+					wchar_t* raw = paths[i].getRaw();
+					for (size_t k = 0; k < paths[i].getLength(); k++) {
+						raw[k] = towlower(raw[k]);
+					}
+				}
+				double towlowerTime = towlowerWatch.getTimeExpiredSeconds();
+
+				CPUWatch upperWatch;
+				for (size_t i = 0; i < paths.getLength(); i++) {
+					paths[i].toUpperCase();
+				}
+				double upperTime = upperWatch.getTimeExpiredSeconds();
+
+				CPUWatch lowerWatch;
+				for (size_t i = 0; i < paths.getLength(); i++) {
+					paths[i].toLowerCase();
+				}
+				double lowerTime = lowerWatch.getTimeExpiredSeconds();
+
+				std::cout << "towlower: " << towlowerTime << " toUpperCase: " << upperTime << " toLowerCase: " << lowerTime << std::endl;
+			}
+		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,315 @@
+#pragma once
+
+#include <cstdint>
+#include <cwchar>
+#include "UtilMath.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define BBE_STRING_SEARCH_USE_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef __AVX2__
+#define BBE_STRING_SEARCH_USE_AVX2
+#include <immintrin.h>
+#endif
+
+namespace bbe
+{
+	namespace INTERNAL
+	{
+		//The filter verifies its candidates with wmemcmp, which is quadratic in the worst case. For needles
+		//of at least this length, the search switches to Two-Way once the failed verifications cost more
+		//than scanning the haystack. Shorter needles are cheap enough to verify.
+		static constexpr size_t STRING_SEARCH_TWO_WAY_MIN_LENGTH = 32;
+		static constexpr size_t STRING_SEARCH_FAILED_CANDIDATE_SLACK = 16;
+
+		inline const wchar_t* stringSearchTwoWay(const wchar_t* haystack, size_t haystackLength, const wchar_t* needle, size_t needleLength);
+
+		inline bool stringSearchMatchesMiddle(const wchar_t* candidate, const wchar_t* needle, size_t needleLength)
+		{
+			//First and last character are already known to match.
+			return needleLength <= 2 || wmemcmp(candidate + 1, needle + 1, needleLength - 2) == 0;
+		}
+
+		inline const wchar_t* stringSearchFilterScalar(const wchar_t* haystack, size_t start, size_t haystackLength, const wchar_t* needle, size_t needleLength)
+		{
+			const wchar_t first = needle[0];
+			const wchar_t last = needle[needleLength - 1];
+			for (size_t i = start; i + needleLength <= haystackLength; i++)
+			{
+				if (haystack[i] == first && haystack[i + needleLength - 1] == last && stringSearchMatchesMiddle(haystack + i, needle, needleLength))
+				{
+					return haystack + i;
+				}
+			}
+			return nullptr;
+		}
+
+#ifdef BBE_STRING_SEARCH_USE_AVX2
+		inline __m256i stringSearchBroadcast256(wchar_t c)
+		{
+			return sizeof(wchar_t) == 2 ? _mm256_set1_epi16((short)c) : _mm256_set1_epi32((int)c);
+		}
+
+		inline uint32_t stringSearchEqualMask256(__m256i a, __m256i b)
+		{
+			return (uint32_t)_mm256_movemask_epi8(sizeof(wchar_t) == 2 ? _mm256_cmpeq_epi16(a, b) : _mm256_cmpeq_epi32(a, b));
+		}
+#endif
+
+#ifdef BBE_STRING_SEARCH_USE_SSE2
+		inline __m128i stringSearchBroadcast128(wchar_t c)
+		{
+			return sizeof(wchar_t) == 2 ? _mm_set1_epi16((short)c) : _mm_set1_epi32((int)c);
+		}
+
+		inline uint32_t stringSearchEqualMask128(__m128i a, __m128i b)
+		{
+			return (uint32_t)_mm_movemask_epi8(sizeof(wchar_t) == 2 ? _mm_cmpeq_epi16(a, b) : _mm_cmpeq_epi32(a, b));
+		}
+#endif
+
+		inline const wchar_t* stringSearchFilter(const wchar_t* haystack, size_t haystackLength, const wchar_t* needle, size_t needleLength)
+		{
+			//Compares a whole vector of positions against the first character of the needle and the
+			//same positions shifted by needleLength - 1 against its last character. Only positions where
+			//both match are verified, which skips almost all positions of real text at once.
+			//needleLength has to be at least 2.
+			const bool useTwoWay = needleLength >= STRING_SEARCH_TWO_WAY_MIN_LENGTH;
+			size_t failedCandidates = 0;
+			//The compare masks have one bit per byte, so every matching wchar_t sets this many bits.
+			const uint32_t elementBits = ((uint32_t)1 << sizeof(wchar_t)) - 1;
+			size_t i = 0;
+#ifdef BBE_STRING_SEARCH_USE_AVX2
+			{
+				constexpr size_t elementsPerVector = 32 / sizeof(wchar_t);
+				const __m256i first = stringSearchBroadcast256(needle[0]);
+				const __m256i last = stringSearchBroadcast256(needle[needleLength - 1]);
+				for (; i + needleLength - 1 + elementsPerVector <= haystackLength; i += elementsPerVector)
+				{
+					const __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i));
+					const __m256i blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i + needleLength - 1));
+					uint32_t mask = stringSearchEqualMask256(blockFirst, first) & stringSearchEqualMask256(blockLast, last);
+					while (mask != 0)
+					{
+						const uint32_t bit = countTrailingZeros(mask);
+						const wchar_t* candidate = haystack + i + bit / sizeof(wchar_t);
+						if (stringSearchMatchesMiddle(candidate, needle, needleLength))
+						{
+							return candidate;
+						}
+						if (useTwoWay && ++failedCandidates > i / needleLength + STRING_SEARCH_FAILED_CANDIDATE_SLACK)
+						{
+							return stringSearchTwoWay(candidate, haystackLength - (candidate - haystack), needle, needleLength);
+						}
+						mask &= ~(elementBits << bit);
+					}
+				}
+			}
+#endif
+#ifdef BBE_STRING_SEARCH_USE_SSE2
+			{
+				constexpr size_t elementsPerVector = 16 / sizeof(wchar_t);
+				const __m128i first = stringSearchBroadcast128(needle[0]);
+				const __m128i last = stringSearchBroadcast128(needle[needleLength - 1]);
+				for (; i + needleLength - 1 + elementsPerVector <= haystackLength; i += elementsPerVector)
+				{
+					const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i));
+					const __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i + needleLength - 1));
+					uint32_t mask = stringSearchEqualMask128(blockFirst, first) & stringSearchEqualMask128(blockLast, last);
+					while (mask != 0)
+					{
+						const uint32_t bit = countTrailingZeros(mask);
+						const wchar_t* candidate = haystack + i + bit / sizeof(wchar_t);
+						if (stringSearchMatchesMiddle(candidate, needle, needleLength))
+						{
+							return candidate;
+						}
+						if (useTwoWay && ++failedCandidates > i / needleLength + STRING_SEARCH_FAILED_CANDIDATE_SLACK)
+						{
+							return stringSearchTwoWay(candidate, haystackLength - (candidate - haystack), needle, needleLength);
+						}
+						mask &= ~(elementBits << bit);
+					}
+				}
+			}
+#endif
+			return stringSearchFilterScalar(haystack, i, haystackLength, needle, needleLength);
+		}
+
+		inline size_t stringSearchCriticalFactorization(const wchar_t* needle, size_t needleLength, size_t& period)
+		{
+			//Crochemore-Perrin: the needle is split at the later of its maximal suffixes for both
+			//orderings of the alphabet. period is set to the period of the right part.
+			size_t maxSuffix = SIZE_MAX;
+			size_t j = 0;
+			size_t k = 1;
+			size_t p = 1;
+			while (j + k < needleLength)
+			{
+				const wchar_t a = needle[j + k];
+				const wchar_t b = needle[maxSuffix + k];
+				if (a < b)
+				{
+					j += k;
+					k = 1;
+					p = j - maxSuffix;
+				}
+				else if (a == b)
+				{
+					if (k != p)
+					{
+						k++;
+					}
+					else
+					{
+						j += p;
+						k = 1;
+					}
+				}
+				else
+				{
+					maxSuffix = j++;
+					k = p = 1;
+				}
+			}
+			period = p;
+
+			size_t maxSuffixReversed = SIZE_MAX;
+			j = 0;
+			k = p = 1;
+			while (j + k < needleLength)
+			{
+				const wchar_t a = needle[j + k];
+				const wchar_t b = needle[maxSuffixReversed + k];
+				if (b < a)
+				{
+					j += k;
+					k = 1;
+					p = j - maxSuffixReversed;
+				}
+				else if (a == b)
+				{
+					if (k != p)
+					{
+						k++;
+					}
+					else
+					{
+						j += p;
+						k = 1;
+					}
+				}
+				else
+				{
+					maxSuffixReversed = j++;
+					k = p = 1;
+				}
+			}
+
+			if (maxSuffixReversed + 1 < maxSuffix + 1)
+			{
+				return maxSuffix + 1;
+			}
+			period = p;
+			return maxSuffixReversed + 1;
+		}
+
+		inline const wchar_t* stringSearchTwoWay(const wchar_t* haystack, size_t haystackLength, const wchar_t* needle, size_t needleLength)
+		{
+			//Linear time in the worst case and constant memory. The right part of the needle is matched
+			//first; a mismatch there shifts by the amount matched, a mismatch in the left part by the period.
+			size_t period = 1;
+			size_t suffix = needleLength - 1;
+			if (needleLength >= 3)
+			{
+				suffix = stringSearchCriticalFactorization(needle, needleLength, period);
+			}
+
+			if (wmemcmp(needle, needle + period, suffix) == 0)
+			{
+				//The needle is periodic. Remember how much of the right part is known to match after a
+				//shift by the period, so it is not compared again.
+				size_t memory = 0;
+				size_t j = 0;
+				while (j + needleLength <= haystackLength)
+				{
+					size_t i = suffix > memory ? suffix : memory;
+					while (i < needleLength && needle[i] == haystack[i + j])
+					{
+						i++;
+					}
+					if (i >= needleLength)
+					{
+						i = suffix - 1;
+						while (memory < i + 1 && needle[i] == haystack[i + j])
+						{
+							i--;
+						}
+						if (i + 1 < memory + 1)
+						{
+							return haystack + j;
+						}
+						j += period;
+						memory = needleLength - period;
+					}
+					else
+					{
+						j += i - suffix + 1;
+						memory = 0;
+					}
+				}
+			}
+			else
+			{
+				period = (suffix > needleLength - suffix ? suffix : needleLength - suffix) + 1;
+				size_t j = 0;
+				while (j + needleLength <= haystackLength)
+				{
+					size_t i = suffix;
+					while (i < needleLength && needle[i] == haystack[i + j])
+					{
+						i++;
+					}
+					if (i >= needleLength)
+					{
+						i = suffix - 1;
+						while (i != SIZE_MAX && needle[i] == haystack[i + j])
+						{
+							i--;
+						}
+						if (i == SIZE_MAX)
+						{
+							return haystack + j;
+						}
+						j += period;
+					}
+					else
+					{
+						j += i - suffix + 1;
+					}
+				}
+			}
+			return nullptr;
+		}
+	}
+
+	inline const wchar_t* stringSearch(const wchar_t* haystack, size_t haystackLength, const wchar_t* needle, size_t needleLength)
+	{
+		//Returns the first occurrence of needle in haystack, or nullptr. Neither has to be 0 terminated.
+		//An empty needle is found at the start of the haystack.
+		if (needleLength == 0)
+		{
+			return haystack;
+		}
+		if (needleLength > haystackLength)
+		{
+			return nullptr;
+		}
+		if (needleLength == 1)
+		{
+			return wmemchr(haystack, needle[0], haystackLength);
+		}
+		return INTERNAL::stringSearchFilter(haystack, haystackLength, needle, needleLength);
+	}
+}
\ No newline at end of file
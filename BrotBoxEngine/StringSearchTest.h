@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <cwchar>
+#include "List.h"
+#include "String.h"
+#include "StringSearch.h"
+#include "UtilTest.h"
+
+namespace bbe
+{
+	namespace test
+	{
+		const wchar_t* stringSearchNaive(const wchar_t* haystack, size_t haystackLength, const wchar_t* needle, size_t needleLength)
+		{
+			for (size_t i = 0; i + needleLength <= haystackLength; i++)
+			{
+				if (wmemcmp(haystack + i, needle, needleLength) == 0)
+				{
+					return haystack + i;
+				}
+			}
+			return nullptr;
+		}
+
+		void testStringSearch()
+		{
+			{
+				const wchar_t* text = L"The quick brown fox jumps over the lazy dog";
+				const size_t length = wcslen(text);
+				assertEquals(stringSearch(text, length, L"fox", 3), text + 16);
+				assertEquals(stringSearch(text, length, L"dog", 3), text + 40);
+				assertEquals(stringSearch(text, length, L"The", 3), text);
+				assertEquals(stringSearch(text, length, L"cat", 3), nullptr);
+				assertEquals(stringSearch(text, length, L"g", 1), text + 42);
+				assertEquals(stringSearch(text, length, L"", 0), text);
+				assertEquals(stringSearch(text, 3, L"The quick", 9), nullptr);
+				//The needle must not be found past haystackLength.
+				assertEquals(stringSearch(text, 42, L"dog", 3), nullptr);
+			}
+
+			{
+				//Random text over small alphabets produces many candidates for every code path: short
+				//needles, long periodic needles and long needles that only differ near the end.
+				uint32_t random = 987654321;
+				for (size_t alphabet = 2; alphabet <= 5; alphabet++)
+				{
+					List<wchar_t> haystack;
+					for (size_t i = 0; i < 3000; i++)
+					{
+						random = random * 1664525 + 1013904223;
+						haystack.pushBack(L'a' + (wchar_t)((random >> 16) % alphabet));
+					}
+					for (size_t needleLength = 1; needleLength <= 80; needleLength += 3)
+					{
+						for (size_t trial = 0; trial < 8; trial++)
+						{
+							List<wchar_t> needle;
+							random = random * 1664525 + 1013904223;
+							const size_t start = (random >> 8) % (haystack.getLength() - needleLength);
+							for (size_t i = 0; i < needleLength; i++)
+							{
+								needle.pushBack(haystack[start + i]);
+							}
+							if (trial % 2 == 1)
+							{
+								//Mostly not found, but with long matching prefixes.
+								needle.last() = L'a' + (wchar_t)(trial % alphabet);
+							}
+							if (trial == 7)
+							{
+								for (size_t i = 0; i < needleLength; i++)
+								{
+									needle[i] = L'a' + (wchar_t)(i % 2);
+								}
+							}
+							const wchar_t* expected = stringSearchNaive(haystack.getRaw(), haystack.getLength(), needle.getRaw(), needleLength);
+							assertEquals(stringSearch(haystack.getRaw(), haystack.getLength(), needle.getRaw(), needleLength), expected);
+							assertEquals(INTERNAL::stringSearchTwoWay(haystack.getRaw(), haystack.getLength(), needle.getRaw(), needleLength), expected);
+						}
+					}
+				}
+			}
+
+			{
+				//Long needles on an adversarial haystack switch from the filter to Two-Way.
+				List<wchar_t> haystack(20000, L'a');
+				List<wchar_t> needle(100, L'a');
+				needle[50] = L'b';
+				assertEquals(stringSearch(haystack.getRaw(), haystack.getLength(), needle.getRaw(), needle.getLength()), nullptr);
+				haystack[19950] = L'b';
+				assertEquals(stringSearch(haystack.getRaw(), haystack.getLength(), needle.getRaw(), needle.getLength()), haystack.getRaw() + 19900);
+			}
+
+			{
+				String log("INFO start;WARN disk;;INFO done;");
+				assertEquals(log.count(";"), 4);
+				assertEquals(log.search("WARN"), 11);
+				assertEquals(log.contains("ERROR"), false);
+				DynamicArray<String> lines = log.split(";");
+				assertEquals(lines.getLength(), 5);
+				assertEquals(lines[0], "INFO start");
+				assertEquals(lines[1], "WARN disk");
+				assertEquals(lines[2], "");
+				assertEquals(lines[3], "INFO done");
+				assertEquals(lines[4], "");
+				assertEquals(lines[0].getCapacity(), lines[0].getLength() > String::SSO_CAPACITY ? lines[0].getLength() + 1 : String::SSO_CAPACITY + 1);
+
+				DynamicArray<String> whole = log.split("nothing");
+				assertEquals(whole.getLength(), 1);
+				assertEquals(whole[0], log);
+				DynamicArray<String> empty = String().split(";");
+				assertEquals(empty.getLength(), 1);
+				assertEquals(empty[0], "");
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "Hash.h"
 #include "String.h"
+#include "StringView.h"
+#include <clocale>
 #include <iostream>
 #include <string>
 #include "UtilTest.h"
@@ -35,7 +38,7 @@ namespace bbe {
 			assertEquals(stringClassic.getLength()         , 13);
 			assertEquals(stringStd.getLength()             , 10);
 			assertEquals(stringStdw.getLength()            , 11);
-			assertEquals(stringNumber.getLength()          , 11);
+			assertEquals(stringNumber.getLength()          , 8);
 			assertEquals(stringCopyConstructor.getLength() , 11);
 			assertEquals(stringMovedTo.getLength()         , 16);
 			assertEquals(stringAssignmentFrom.getLength()  , 19);
@@ -209,6 +212,22 @@ namespace bbe {
 				assertEquals(stringTrim, "");
 			}
 
+			{
+				bbe::String stringTrim;
+				stringTrim.trim();
+				assertEquals(stringTrim, "");
+				assertEquals(stringTrim.getLength(), 0);
+			}
+
+			{
+				bbe::String stringTrim("a");
+				stringTrim.trim();
+				assertEquals(stringTrim, "a");
+				stringTrim = " \t\r\n\v\fb c\n";
+				stringTrim.trim();
+				assertEquals(stringTrim, "b c");
+			}
+
 			{
 				bbe::String countTest("Some stuff in this string will get counted! this is gonna be cool!");
 				assertEquals(countTest.count(bbe::String("s")), 5);
@@ -530,14 +549,14 @@ namespace bbe {
 			assertUnequals(stringStdw, L"HalloWSTD!");
 			assertUnequals(L"HalloWSTD!", stringStdw);
 			
-			assertEquals  (stringNumber, "2839.192000");
-			assertEquals  ("2839.192000", stringNumber);
-			assertUnequals(stringNumber, "2839.392000");
-			assertUnequals("2839.392000", stringNumber);
-			assertEquals  (stringNumber, L"2839.192000");
-			assertEquals  (L"2839.192000", stringNumber);
-			assertUnequals(stringNumber, L"2839.392000");
-			assertUnequals(L"2839.392000", stringNumber);
+			assertEquals  (stringNumber, "2839.192");
+			assertEquals  ("2839.192", stringNumber);
+			assertUnequals(stringNumber, "2839.392");
+			assertUnequals("2839.392", stringNumber);
+			assertEquals  (stringNumber, L"2839.192");
+			assertEquals  (L"2839.192", stringNumber);
+			assertUnequals(stringNumber, L"2839.392");
+			assertUnequals(L"2839.392", stringNumber);
 
 			assertEquals  (stringCopyConstructor, "Hallo WChar");
 			assertEquals  ("Hallo WChar", stringCopyConstructor);
@@ -583,6 +602,179 @@ namespace bbe {
 			assertEquals  (L"I will be move-assigned!", stringMoveAssignmentTo);
 			assertUnequals(stringMoveAssignmentTo, L"I will be moveassigned!");
 			assertUnequals(L"I will be move-asigned!", stringMoveAssignmentTo);
+
+			{
+				bbe::String text("Searching through a text that is longer than the SSO storage");
+				bbe::StringView view(L"text that", 4);
+				assertEquals(view.getLength(), 4);
+				assertEquals(view, L"text");
+				assertEquals(view.substring(1, 2), L"ex");
+				assertEquals(text.search(view), 20);
+				assertEquals(text.count(view), 1);
+				assertEquals(text.contains(view), true);
+				assertEquals(text.contains(bbe::StringView(L"texts", 5)), false);
+				assertEquals(text.search(std::string("than")), 40);
+				assertEquals(text.search(std::wstring(L"SSO")), 49);
+				assertEquals(text.search(""), 0);
+				assertEquals(text.count(""), 0);
+				assertEquals(text.count("t"), 8);
+
+				bbe::StringView textView = text;
+				assertEquals(textView.getLength(), text.getLength());
+				assertEquals(text == textView, true);
+				assertEquals(text == textView.substring(0, 9), false);
+				assertEquals(bbe::String(textView.substring(0, 9)), "Searching");
+				assertEquals(text == "Searching through a text that is longer than the SSO storage", true);
+				assertEquals(text == "Searching through a text that is longer than the SSO storag", false);
+				assertEquals(text == std::string("Searching through a text that is longer than the SSO storage"), true);
+				assertEquals(bbe::String("abc") == bbe::StringView(L"abcd", 3), true);
+
+				bbe::DynamicArray<bbe::String> parts = text.split(bbe::StringView(L" a", 2));
+				assertEquals(parts.getLength(), 2);
+				assertEquals(parts[0], "Searching through");
+				assertEquals(parts[1], " text that is longer than the SSO storage");
+			}
+
+			{
+				bbe::String longString = bbe::String("A string that is long enough ") + "to live on the heap";
+				longString += ", and then some more.";
+				assertEquals(longString, "A string that is long enough to live on the heap, and then some more.");
+				bbe::String selfAppend("Twice ");
+				selfAppend += selfAppend;
+				assertEquals(selfAppend, "Twice Twice ");
+				selfAppend += selfAppend;
+				assertEquals(selfAppend, "Twice Twice Twice Twice ");
+				selfAppend += bbe::StringView(selfAppend.getRaw(), 6);
+				assertEquals(selfAppend, "Twice Twice Twice Twice Twice ");
+				bbe::String prefixed = bbe::StringView(L"pre") + bbe::String("fix");
+				assertEquals(prefixed, "prefix");
+				prefixed += std::string(200, 'x');
+				assertEquals(prefixed.getLength(), 206);
+			}
+
+			{
+				bbe::String csv("name,,value,");
+				bbe::StringView pieces[4];
+				size_t amountOfPieces = 0;
+				for (const bbe::StringView& piece : csv.splitView(L","))
+				{
+					pieces[amountOfPieces++] = piece;
+				}
+				assertEquals(amountOfPieces, 4);
+				assertEquals(pieces[0], bbe::StringView(L"name"));
+				assertEquals(pieces[1], bbe::StringView(L""));
+				assertEquals(pieces[2], bbe::StringView(L"value"));
+				assertEquals(pieces[3], bbe::StringView(L""));
+				assertEquals(pieces[0].getRaw(), csv.getRaw());
+				assertEquals(pieces[2].getRaw(), csv.getRaw() + 6);
+
+				amountOfPieces = 0;
+				for (const bbe::StringView& piece : csv.splitView(L";"))
+				{
+					assertEquals(piece, bbe::StringView(csv));
+					amountOfPieces++;
+				}
+				assertEquals(amountOfPieces, 1);
+
+				amountOfPieces = 0;
+				for (const bbe::StringView& piece : bbe::String().splitView(L","))
+				{
+					assertEquals(piece.isEmpty(), true);
+					amountOfPieces++;
+				}
+				assertEquals(amountOfPieces, 1);
+
+				bbe::String table("a=1;bb=22;ccc=333");
+				size_t sum = 0;
+				for (const bbe::StringView& entry : table.splitView(L";"))
+				{
+					auto keyValue = entry.splitView(L"=").begin();
+					size_t keyLength = (*keyValue).getLength();
+					++keyValue;
+					assertEquals((*keyValue).getLength(), keyLength);
+					sum += keyLength;
+				}
+				assertEquals(sum, 6);
+
+				auto owned = csv.split(L",");
+				assertEquals(owned.getLength(), 4);
+				assertEquals(owned[2], "value");
+				assertEquals(owned[2].getCapacity(), String::SSO_CAPACITY + 1);
+			}
+
+			{
+				assertEquals(sizeof(String), 32);
+
+				String atLimit(StringView(L"abcdefghijklmnopqrstuvwxyz", String::SSO_CAPACITY));
+				assertEquals(atLimit.getLength(), String::SSO_CAPACITY);
+				assertEquals(atLimit.getCapacity(), String::SSO_CAPACITY + 1);
+				assertEquals(atLimit.getRaw()[String::SSO_CAPACITY], 0);
+
+				String overLimit = atLimit + "z";
+				assertEquals(overLimit.getLength(), String::SSO_CAPACITY + 1);
+				assertEquals(overLimit.getCapacity() > String::SSO_CAPACITY + 1, true);
+				assertEquals(overLimit.getRaw()[String::SSO_CAPACITY], L'z');
+				assertEquals(overLimit.getRaw()[String::SSO_CAPACITY + 1], 0);
+				assertEquals(overLimit.getHash(), Hash<StringView>()(overLimit));
+				assertEquals(atLimit.getHash(), Hash<StringView>()(atLimit));
+
+				String moved(std::move(overLimit));
+				assertEquals(overLimit, "");
+				assertEquals(overLimit.getLength(), 0);
+				assertEquals(moved.getLength(), String::SSO_CAPACITY + 1);
+				overLimit = std::move(atLimit);
+				assertEquals(atLimit, "");
+				assertEquals(overLimit.getLength(), String::SSO_CAPACITY);
+				moved = overLimit;
+				assertEquals(moved, overLimit);
+				moved.trim();
+				moved.getRaw()[0] = L'-';
+				assertEquals(moved.getHash(), Hash<StringView>()(moved));
+				assertUnequals(moved, overLimit);
+			}
+
+			{
+				//Pointers and references that were taken before getHash may still be written through.
+				String held("A string that is too long for the short storage");
+				wchar_t* raw = held.getRaw();
+				wchar_t& last = held[held.getLength() - 1];
+				assertEquals(held.getHash(), Hash<StringView>()(held));
+				raw[0] = L'a';
+				assertEquals(held.getHash(), Hash<StringView>()(held));
+				last = L'S';
+				assertEquals(held.getHash(), Hash<StringView>()(held));
+				assertEquals(held, "a string that is too long for the short storagS");
+
+				//A new buffer can cache its hash again.
+				held += " and longer";
+				assertEquals(held.getHash(), Hash<StringView>()(held));
+				assertEquals(held.getHash(), Hash<StringView>()(held));
+			}
+
+			{
+				//char text is converted with the current locale. In a UTF-8 locale "gr\xC3\xBC\xC3\x9F" is four
+				//characters, even though it is six bytes.
+				const char* utf8 = "gr\xC3\xBC\xC3\x9F";
+				const char* longUtf8 = "\xC3\xBC\xC3\x9F\xC3\xBC\xC3\x9F\xC3\xBC\xC3\x9F\xC3\xBC\xC3\x9F\xC3\xBC\xC3\x9F";
+				const std::string previousLocale = setlocale(LC_CTYPE, nullptr);
+				const bool hasUtf8 = setlocale(LC_CTYPE, "C.UTF-8") != nullptr || setlocale(LC_CTYPE, ".UTF8") != nullptr;
+
+				String shortString(utf8);
+				String longString(longUtf8);
+				String fromStdString = std::string(longUtf8);
+				assertEquals(shortString == utf8, true);
+				assertEquals(longString == longUtf8, true);
+				assertEquals(fromStdString, longString);
+				if (hasUtf8)
+				{
+					assertEquals(shortString.getLength(), 4);
+					assertEquals(shortString == L"gr\u00FC\u00DF", true);
+					assertEquals(longString.getLength(), 10);
+					assertEquals(longString.getRaw()[10], 0);
+				}
+
+				setlocale(LC_CTYPE, previousLocale.c_str());
+			}
 		}
 	}
 }
\ No newline at end of file
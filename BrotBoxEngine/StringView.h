@@ -0,0 +1,193 @@
+#pragma once
+
+#include <cwchar>
+#include <string>
+#include "StringSearch.h"
+#include "UtilDebug.h"
+
+namespace bbe
+{
+	class StringViewSplitRange;
+
+	class StringView
+	{
+		//Non owning view of wchar_t text, a pointer and a length. The text does not have to be 0
+		//terminated, so getRaw() must not be passed to functions that expect a C string.
+	private:
+		const wchar_t* m_data;
+		size_t m_length;
+
+	public:
+		StringView()
+			: m_data(L""), m_length(0)
+		{
+			//do nothing
+		}
+
+		StringView(const wchar_t* data)
+			: m_data(data), m_length(wcslen(data))
+		{
+			//do nothing
+		}
+
+		StringView(const wchar_t* data, size_t length)
+			: m_data(data), m_length(length)
+		{
+			//do nothing
+		}
+
+		StringView(const std::wstring& data)
+			: m_data(data.c_str()), m_length(data.length())
+		{
+			//do nothing
+		}
+
+		bool operator==(const StringView& other) const
+		{
+			return m_length == other.m_length && wmemcmp(m_data, other.m_data, m_length) == 0;
+		}
+
+		bool operator!=(const StringView& other) const
+		{
+			return !operator==(other);
+		}
+
+		wchar_t operator[](size_t index) const
+		{
+			return m_data[index];
+		}
+
+		StringView substring(size_t start, size_t length) const
+		{
+			if (start > m_length || length > m_length - start)
+			{
+				debugBreak();
+			}
+			return StringView(m_data + start, length);
+		}
+
+		const wchar_t* getRaw() const
+		{
+			return m_data;
+		}
+
+		size_t getLength() const
+		{
+			return m_length;
+		}
+
+		bool isEmpty() const
+		{
+			return m_length == 0;
+		}
+
+		const wchar_t* begin() const
+		{
+			return m_data;
+		}
+
+		const wchar_t* end() const
+		{
+			return m_data + m_length;
+		}
+
+		StringViewSplitRange splitView(const StringView& splitAt) const;
+	};
+
+	class StringViewSplitIterator
+	{
+		//Yields the pieces between the occurrences of the separator, including empty ones. Each piece is
+		//searched for when the iterator is advanced, nothing is allocated.
+	private:
+		const wchar_t* m_pieceStart;
+		const wchar_t* m_pieceEnd;
+		const wchar_t* m_end;
+		StringView m_splitAt;
+		bool m_isLastPiece;
+
+		void findPieceEnd()
+		{
+			const wchar_t* finding = nullptr;
+			if (!m_splitAt.isEmpty())
+			{
+				finding = stringSearch(m_pieceStart, m_end - m_pieceStart, m_splitAt.getRaw(), m_splitAt.getLength());
+			}
+			m_isLastPiece = finding == nullptr;
+			m_pieceEnd = m_isLastPiece ? m_end : finding;
+		}
+
+	public:
+		StringViewSplitIterator()
+			: m_pieceStart(nullptr), m_pieceEnd(nullptr), m_end(nullptr), m_isLastPiece(true)
+		{
+			//do nothing
+		}
+
+		StringViewSplitIterator(const StringView& text, const StringView& splitAt)
+			: m_pieceStart(text.getRaw()), m_end(text.getRaw() + text.getLength()), m_splitAt(splitAt)
+		{
+			findPieceEnd();
+		}
+
+		StringView operator*() const
+		{
+			return StringView(m_pieceStart, m_pieceEnd - m_pieceStart);
+		}
+
+		StringViewSplitIterator& operator++()
+		{
+			if (m_isLastPiece)
+			{
+				m_pieceStart = nullptr;
+				m_pieceEnd = nullptr;
+			}
+			else
+			{
+				m_pieceStart = m_pieceEnd + m_splitAt.getLength();
+				findPieceEnd();
+			}
+			return *this;
+		}
+
+		bool operator==(const StringViewSplitIterator& other) const
+		{
+			return m_pieceStart == other.m_pieceStart;
+		}
+
+		bool operator!=(const StringViewSplitIterator& other) const
+		{
+			return m_pieceStart != other.m_pieceStart;
+		}
+	};
+
+	class StringViewSplitRange
+	{
+		//Lazy result of splitView. Only points into the text and the separator, so both have to outlive
+		//the range and must not be modified while it is used.
+	private:
+		StringView m_text;
+		StringView m_splitAt;
+
+	public:
+		StringViewSplitRange(const StringView& text, const StringView& splitAt)
+			: m_text(text), m_splitAt(splitAt)
+		{
+			//do nothing
+		}
+
+		StringViewSplitIterator begin() const
+		{
+			return StringViewSplitIterator(m_text, m_splitAt);
+		}
+
+		StringViewSplitIterator end() const
+		{
+			return StringViewSplitIterator();
+		}
+	};
+
+	inline StringViewSplitRange StringView::splitView(const StringView& splitAt) const
+	{
+		return StringViewSplitRange(*this, splitAt);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,350 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cwchar>
+#include <mutex>
+#include "ConcurrentHashMap.h"
+#include "Hash.h"
+#include "List.h"
+#include "String.h"
+#include "StringView.h"
+#include "UtilDebug.h"
+
+namespace bbe
+{
+	class SymbolTable;
+
+	class Symbol
+	{
+		//Interned string, represented by a 32 bit id into the global SymbolTable. Equal texts always get
+		//the same id, so comparing and hashing never looks at the characters. The default constructed
+		//Symbol is the empty string and has id 0.
+		friend class SymbolTable;
+	private:
+		uint32_t m_id = 0;
+
+		explicit Symbol(uint32_t id)
+			: m_id(id)
+		{
+			//do nothing
+		}
+
+	public:
+		Symbol()
+		{
+			//do nothing
+		}
+
+		explicit Symbol(const StringView& text);
+		explicit Symbol(const String& text);
+		explicit Symbol(const wchar_t* text);
+		explicit Symbol(const char* text);
+
+		bool operator==(const Symbol& other) const
+		{
+			return m_id == other.m_id;
+		}
+
+		bool operator!=(const Symbol& other) const
+		{
+			return m_id != other.m_id;
+		}
+
+		bool operator<(const Symbol& other) const
+		{
+			//Orders by id, which is the order of interning and not the alphabetical one.
+			return m_id < other.m_id;
+		}
+
+		uint32_t getId() const
+		{
+			return m_id;
+		}
+
+		bool isEmpty() const
+		{
+			return m_id == 0;
+		}
+
+		StringView getView() const;
+		size_t getHash() const;
+
+		const wchar_t* getRaw() const
+		{
+			//Always 0 terminated.
+			return getView().getRaw();
+		}
+
+		size_t getLength() const
+		{
+			return getView().getLength();
+		}
+
+		String toString() const
+		{
+			return String(getView());
+		}
+
+		operator StringView() const
+		{
+			return getView();
+		}
+	};
+
+	namespace INTERNAL
+	{
+		struct SymbolEntry
+		{
+			const wchar_t* m_data;
+			size_t m_hash;
+			uint32_t m_length;
+			uint32_t m_nextWithSameHash;
+		};
+	}
+
+	class SymbolTable
+	{
+		//Maps texts to Symbol ids. Every text is stored once, 0 terminated, in an arena of blocks that are
+		//never moved or freed, so the views handed out by Symbols stay valid for the whole program.
+		//The ConcurrentHashMap maps the hash of a text to the newest id with that hash, further ids with
+		//the same hash are chained through the entries. Looking up a known text does not lock. Entries
+		//are immutable once published and live in pages that are never reallocated, so a reader can
+		//follow an id without synchronizing with writers.
+	private:
+		static constexpr size_t ENTRIES_PER_PAGE = 4096;
+		static constexpr size_t MAX_AMOUNT_OF_PAGES = 4096;
+		static constexpr size_t ARENA_BLOCK_SIZE = 64 * 1024;
+
+		ConcurrentHashMap<size_t, uint32_t> m_idsByHash;
+		std::atomic<INTERNAL::SymbolEntry*> m_pages[MAX_AMOUNT_OF_PAGES];
+		std::atomic<uint32_t> m_nextId;
+
+		std::mutex m_storageMutex;
+		List<wchar_t*> m_arenaBlocks;
+		wchar_t* m_arenaPosition = nullptr;
+		size_t m_arenaLeft = 0;
+
+		SymbolTable()
+			: m_nextId(1)
+		{
+			for (size_t i = 0; i < MAX_AMOUNT_OF_PAGES; i++)
+			{
+				m_pages[i].store(nullptr, std::memory_order_relaxed);
+			}
+		}
+
+		const INTERNAL::SymbolEntry& getEntry(uint32_t id) const
+		{
+			return m_pages[id / ENTRIES_PER_PAGE].load(std::memory_order_acquire)[id % ENTRIES_PER_PAGE];
+		}
+
+		static size_t hashText(const StringView& text)
+		{
+			return Hash<StringView>()(text);
+		}
+
+		uint32_t findInChain(uint32_t id, const StringView& text, size_t hash) const
+		{
+			while (id != 0)
+			{
+				const INTERNAL::SymbolEntry& entry = getEntry(id);
+				if (entry.m_hash == hash && StringView(entry.m_data, entry.m_length) == text)
+				{
+					return id;
+				}
+				id = entry.m_nextWithSameHash;
+			}
+			return 0;
+		}
+
+		uint32_t addEntry(const StringView& text, size_t hash, uint32_t nextWithSameHash)
+		{
+			//Called with the lock of the shard of hash held, so no other thread adds the same text.
+			const uint32_t id = m_nextId.fetch_add(1, std::memory_order_relaxed);
+			const size_t pageIndex = id / ENTRIES_PER_PAGE;
+			if (pageIndex >= MAX_AMOUNT_OF_PAGES || text.getLength() > UINT32_MAX)
+			{
+				debugBreak();
+			}
+
+			std::lock_guard<std::mutex> lock(m_storageMutex);
+			INTERNAL::SymbolEntry* page = m_pages[pageIndex].load(std::memory_order_relaxed);
+			if (page == nullptr)
+			{
+				page = new INTERNAL::SymbolEntry[ENTRIES_PER_PAGE];
+				m_pages[pageIndex].store(page, std::memory_order_release);
+			}
+
+			const size_t size = text.getLength() + 1;
+			if (size > m_arenaLeft)
+			{
+				const size_t blockSize = size > ARENA_BLOCK_SIZE ? size : ARENA_BLOCK_SIZE;
+				m_arenaPosition = new wchar_t[blockSize];
+				m_arenaLeft = blockSize;
+				m_arenaBlocks.pushBack(m_arenaPosition);
+			}
+			wchar_t* data = m_arenaPosition;
+			wmemcpy(data, text.getRaw(), text.getLength());
+			data[text.getLength()] = 0;
+			m_arenaPosition += size;
+			m_arenaLeft -= size;
+
+			INTERNAL::SymbolEntry& entry = page[id % ENTRIES_PER_PAGE];
+			entry.m_data = data;
+			entry.m_hash = hash;
+			entry.m_length = (uint32_t)text.getLength();
+			entry.m_nextWithSameHash = nextWithSameHash;
+			return id;
+		}
+
+	public:
+		SymbolTable(const SymbolTable& other) = delete;
+		SymbolTable(SymbolTable&& other) = delete;
+		SymbolTable& operator=(const SymbolTable& other) = delete;
+		SymbolTable& operator=(SymbolTable&& other) = delete;
+
+		~SymbolTable()
+		{
+			for (size_t i = 0; i < MAX_AMOUNT_OF_PAGES; i++)
+			{
+				delete[] m_pages[i].load(std::memory_order_relaxed);
+			}
+			for (size_t i = 0; i < m_arenaBlocks.getLength(); i++)
+			{
+				delete[] m_arenaBlocks[i];
+			}
+		}
+
+		static SymbolTable& getGlobal()
+		{
+			static SymbolTable table;
+			return table;
+		}
+
+		Symbol intern(const StringView& text)
+		{
+			if (text.isEmpty())
+			{
+				return Symbol();
+			}
+			const size_t hash = hashText(text);
+			uint32_t head = 0;
+			if (m_idsByHash.get(hash, head))
+			{
+				const uint32_t id = findInChain(head, text, hash);
+				if (id != 0)
+				{
+					return Symbol(id);
+				}
+			}
+
+			uint32_t id = 0;
+			m_idsByHash.upsert(hash,
+				[&](uint32_t& chainHead, bool isNew)
+				{
+					//Another thread may have added the text since the lookup above.
+					id = isNew ? 0 : findInChain(chainHead, text, hash);
+					if (id == 0)
+					{
+						id = addEntry(text, hash, isNew ? 0 : chainHead);
+						chainHead = id;
+					}
+				});
+			return Symbol(id);
+		}
+
+		bool find(const StringView& text, Symbol& out) const
+		{
+			//Like intern, but never adds the text.
+			if (text.isEmpty())
+			{
+				out = Symbol();
+				return true;
+			}
+			const size_t hash = hashText(text);
+			uint32_t head = 0;
+			if (!m_idsByHash.get(hash, head))
+			{
+				return false;
+			}
+			const uint32_t id = findInChain(head, text, hash);
+			if (id == 0)
+			{
+				return false;
+			}
+			out = Symbol(id);
+			return true;
+		}
+
+		StringView getView(Symbol symbol) const
+		{
+			if (symbol.m_id == 0)
+			{
+				return StringView();
+			}
+			const INTERNAL::SymbolEntry& entry = getEntry(symbol.m_id);
+			return StringView(entry.m_data, entry.m_length);
+		}
+
+		size_t getHash(Symbol symbol) const
+		{
+			if (symbol.m_id == 0)
+			{
+				return hashText(StringView());
+			}
+			return getEntry(symbol.m_id).m_hash;
+		}
+
+		size_t getAmountOfSymbols() const
+		{
+			//Without the empty Symbol.
+			return m_nextId.load(std::memory_order_relaxed) - 1;
+		}
+	};
+
+	inline Symbol::Symbol(const StringView& text)
+		: m_id(SymbolTable::getGlobal().intern(text).m_id)
+	{
+		//do nothing
+	}
+
+	inline Symbol::Symbol(const String& text)
+		: Symbol(StringView(text))
+	{
+		//do nothing
+	}
+
+	inline Symbol::Symbol(const wchar_t* text)
+		: Symbol(StringView(text))
+	{
+		//do nothing
+	}
+
+	inline Symbol::Symbol(const char* text)
+	{
+		INTERNAL::WideCharBuffer buffer(text);
+		m_id = SymbolTable::getGlobal().intern(buffer.getView()).m_id;
+	}
+
+	inline StringView Symbol::getView() const
+	{
+		return SymbolTable::getGlobal().getView(*this);
+	}
+
+	inline size_t Symbol::getHash() const
+	{
+		//Hash of the text, computed once when it was interned.
+		return SymbolTable::getGlobal().getHash(*this);
+	}
+
+	template <>
+	class Hash<Symbol>
+	{
+	public:
+		size_t operator()(const Symbol& t) const
+		{
+			return (size_t)hashMix(t.getId());
+		}
+	};
+}
\ No newline at end of file
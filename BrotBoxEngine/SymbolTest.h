@@ -0,0 +1,94 @@
+#pragma once
+
+#include <thread>
+#include "HashMap.h"
+#include "List.h"
+#include "String.h"
+#include "Symbol.h"
+#include "UtilTest.h"
+
+namespace bbe
+{
+	namespace test
+	{
+		void testSymbol()
+		{
+			{
+				Symbol empty;
+				assertEquals(empty.isEmpty(), true);
+				assertEquals(empty.getId(), 0);
+				assertEquals(empty.getLength(), 0);
+				assertEquals(Symbol(""), empty);
+				assertEquals(empty.getHash(), Hash<String>()(String()));
+
+				const size_t symbolsBefore = SymbolTable::getGlobal().getAmountOfSymbols();
+				Symbol shader("shaders/terrain.vert");
+				Symbol sameShader(L"shaders/terrain.vert");
+				Symbol otherShader(String("shaders/terrain.frag"));
+				assertEquals(shader, sameShader);
+				assertUnequals(shader, otherShader);
+				assertEquals(shader.getId(), sameShader.getId());
+				assertEquals(shader.getView().getRaw(), sameShader.getView().getRaw());
+				assertEquals(SymbolTable::getGlobal().getAmountOfSymbols(), symbolsBefore + 2);
+
+				assertEquals(shader.getLength(), 20);
+				assertEquals(shader.getView(), StringView(L"shaders/terrain.vert"));
+				assertEquals(shader.toString(), "shaders/terrain.vert");
+				assertEquals(shader.getRaw()[20], L'\0');
+				assertEquals(shader.getHash(), Hash<String>()(String("shaders/terrain.vert")));
+
+				String text("components/transform");
+				assertEquals(Symbol(StringView(text.getRaw(), 10)), Symbol("components"));
+
+				Symbol found;
+				assertEquals(SymbolTable::getGlobal().find(L"shaders/terrain.frag", found), true);
+				assertEquals(found, otherShader);
+				assertEquals(SymbolTable::getGlobal().find(L"never interned", found), false);
+			}
+
+			{
+				HashMap<Symbol, int> components;
+				components.add(Symbol("Transform"), 1);
+				components.add(Symbol("Mesh"), 2);
+				assertEquals(*components.find(Symbol("Transform")), 1);
+				assertEquals(*components.find(Symbol("Mesh")), 2);
+				assertEquals(components.find(Symbol("Light")), nullptr);
+			}
+
+			{
+				//Every thread interns the same names, all have to end up with the same ids.
+				constexpr size_t amountOfThreads = 4;
+				constexpr int amountOfNames = 2000;
+				List<uint32_t> ids[amountOfThreads];
+				List<std::thread*> threads;
+				for (size_t t = 0; t < amountOfThreads; t++)
+				{
+					ids[t] = List<uint32_t>(amountOfNames, 0u);
+					threads.pushBack(new std::thread(
+						[&ids, t]()
+						{
+							for (int i = 0; i < amountOfNames; i++)
+							{
+								const int name = (i * 7 + (int)t * 13) % amountOfNames;
+								ids[t][name] = Symbol(String("asset_") + name).getId();
+							}
+						}));
+				}
+				for (size_t t = 0; t < threads.getLength(); t++)
+				{
+					threads[t]->join();
+					delete threads[t];
+				}
+				for (int i = 0; i < amountOfNames; i++)
+				{
+					Symbol symbol(String("asset_") + i);
+					assertEquals(symbol.toString(), String("asset_") + i);
+					for (size_t t = 0; t < amountOfThreads; t++)
+					{
+						assertEquals(ids[t][i], symbol.getId());
+					}
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
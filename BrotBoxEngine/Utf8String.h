@@ -0,0 +1,909 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cwchar>
+#include <cwctype>
+#include <ostream>
+#include <string>
+#include "DynamicArray.h"
+#include "List.h"
+#include "NumberConversion.h"
+#include "String.h"
+
+namespace bbe
+{
+	namespace INTERNAL
+	{
+		static constexpr uint32_t UTF8_REPLACEMENT_CHARACTER = 0xFFFD;
+
+		inline size_t utf8Encode(uint32_t codepoint, char* out)
+		{
+			//Writes up to 4 bytes and returns how many were written. Invalid codepoints are encoded as U+FFFD.
+			if (codepoint < 0x80)
+			{
+				out[0] = (char)codepoint;
+				return 1;
+			}
+			if (codepoint < 0x800)
+			{
+				out[0] = (char)(0xC0 | (codepoint >> 6));
+				out[1] = (char)(0x80 | (codepoint & 0x3F));
+				return 2;
+			}
+			if (codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF))
+			{
+				codepoint = UTF8_REPLACEMENT_CHARACTER;
+			}
+			if (codepoint < 0x10000)
+			{
+				out[0] = (char)(0xE0 | (codepoint >> 12));
+				out[1] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+				out[2] = (char)(0x80 | (codepoint & 0x3F));
+				return 3;
+			}
+			out[0] = (char)(0xF0 | (codepoint >> 18));
+			out[1] = (char)(0x80 | ((codepoint >> 12) & 0x3F));
+			out[2] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+			out[3] = (char)(0x80 | (codepoint & 0x3F));
+			return 4;
+		}
+
+		inline size_t utf8EncodedLength(uint32_t codepoint)
+		{
+			if (codepoint < 0x80)
+			{
+				return 1;
+			}
+			if (codepoint < 0x800)
+			{
+				return 2;
+			}
+			if (codepoint < 0x10000 || codepoint > 0x10FFFF)
+			{
+				return 3;
+			}
+			return 4;
+		}
+
+		inline uint32_t utf8Decode(const char*& readHead, const char* end)
+		{
+			//Decodes one codepoint and advances readHead past it. Malformed sequences, overlong encodings
+			//and surrogates decode to U+FFFD and only skip their first byte.
+			const uint8_t* bytes = reinterpret_cast<const uint8_t*>(readHead);
+			const size_t available = end - readHead;
+			const uint8_t first = bytes[0];
+			if (first < 0x80)
+			{
+				readHead++;
+				return first;
+			}
+
+			size_t length;
+			uint32_t codepoint;
+			uint32_t minimum;
+			if ((first & 0xE0) == 0xC0)
+			{
+				length = 2;
+				codepoint = first & 0x1F;
+				minimum = 0x80;
+			}
+			else if ((first & 0xF0) == 0xE0)
+			{
+				length = 3;
+				codepoint = first & 0x0F;
+				minimum = 0x800;
+			}
+			else if ((first & 0xF8) == 0xF0)
+			{
+				length = 4;
+				codepoint = first & 0x07;
+				minimum = 0x10000;
+			}
+			else
+			{
+				readHead++;
+				return UTF8_REPLACEMENT_CHARACTER;
+			}
+
+			if (length > available)
+			{
+				readHead++;
+				return UTF8_REPLACEMENT_CHARACTER;
+			}
+			for (size_t i = 1; i < length; i++)
+			{
+				if ((bytes[i] & 0xC0) != 0x80)
+				{
+					readHead++;
+					return UTF8_REPLACEMENT_CHARACTER;
+				}
+				codepoint = (codepoint << 6) | (bytes[i] & 0x3F);
+			}
+			if (codepoint < minimum || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF))
+			{
+				readHead++;
+				return UTF8_REPLACEMENT_CHARACTER;
+			}
+			readHead += length;
+			return codepoint;
+		}
+
+		inline uint32_t wideDecode(const wchar_t*& readHead, const wchar_t* end)
+		{
+			//wchar_t is UTF-16 on Windows and UTF-32 everywhere else.
+			uint32_t unit = (uint32_t)*readHead;
+			readHead++;
+			if (sizeof(wchar_t) == 2 && unit >= 0xD800 && unit <= 0xDBFF && readHead != end)
+			{
+				const uint32_t low = (uint32_t)*readHead;
+				if (low >= 0xDC00 && low <= 0xDFFF)
+				{
+					readHead++;
+					return 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+				}
+			}
+			return unit;
+		}
+
+		inline size_t wideEncode(uint32_t codepoint, wchar_t* out)
+		{
+			if (sizeof(wchar_t) == 2 && codepoint >= 0x10000)
+			{
+				codepoint -= 0x10000;
+				out[0] = (wchar_t)(0xD800 + (codepoint >> 10));
+				out[1] = (wchar_t)(0xDC00 + (codepoint & 0x3FF));
+				return 2;
+			}
+			out[0] = (wchar_t)codepoint;
+			return 1;
+		}
+
+		inline bool utf8IsWhitespace(char c)
+		{
+			return c == ' ' || (c >= '\t' && c <= '\r');
+		}
+
+		inline uint32_t utf8ChangeCase(uint32_t codepoint, bool toUpper)
+		{
+			if (codepoint > (uint32_t)WCHAR_MAX)
+			{
+				return codepoint;
+			}
+			return (uint32_t)(toUpper ? towupper((wint_t)codepoint) : towlower((wint_t)codepoint));
+		}
+	}
+
+	class Utf8CodepointIterator
+	{
+		//Walks over the codepoints of UTF-8 text. Dereferencing decodes the codepoint at the current
+		//position; malformed bytes are returned as U+FFFD, one at a time.
+	private:
+		const char* m_position;
+		const char* m_end;
+
+	public:
+		Utf8CodepointIterator(const char* position, const char* end)
+			: m_position(position), m_end(end)
+		{
+			//do nothing
+		}
+
+		uint32_t operator*() const
+		{
+			const char* readHead = m_position;
+			return INTERNAL::utf8Decode(readHead, m_end);
+		}
+
+		Utf8CodepointIterator& operator++()
+		{
+			INTERNAL::utf8Decode(m_position, m_end);
+			return *this;
+		}
+
+		bool operator==(const Utf8CodepointIterator& other) const
+		{
+			return m_position == other.m_position;
+		}
+
+		bool operator!=(const Utf8CodepointIterator& other) const
+		{
+			return m_position != other.m_position;
+		}
+
+		const char* getPosition() const
+		{
+			return m_position;
+		}
+	};
+
+	class Utf8CodepointRange
+	{
+	private:
+		const char* m_begin;
+		const char* m_end;
+
+	public:
+		Utf8CodepointRange(const char* begin, const char* end)
+			: m_begin(begin), m_end(end)
+		{
+			//do nothing
+		}
+
+		Utf8CodepointIterator begin() const
+		{
+			return Utf8CodepointIterator(m_begin, m_end);
+		}
+
+		Utf8CodepointIterator end() const
+		{
+			return Utf8CodepointIterator(m_end, m_end);
+		}
+	};
+
+	class Utf8String
+	{
+		//String that stores UTF-8 bytes instead of wchar_t. All lengths and indices are in bytes, the
+		//codepoints are reachable through getCodepoints(). Searching, splitting, counting and comparing
+		//work on the bytes directly, which is correct for UTF-8 as no encoded codepoint is part of
+		//another. wchar_t text is only converted when it enters or leaves (toString) the Utf8String.
+	public:
+		//Amount of bytes, without the terminating 0, that are stored inside the Utf8String itself:
+		//23 on 64 bit, 11 on 32 bit.
+		static constexpr size_t SSO_CAPACITY = 3 * sizeof(size_t) - 1;
+
+	private:
+		//Uses the same layout as String. The last byte of a short string holds SSO_CAPACITY - length, so it
+		//becomes the terminating 0 exactly when the storage is full. A long string keeps its capacity in the
+		//last word, whose highest bit marks it as long. This relies on a little endian layout.
+		static constexpr size_t LONG_FLAG = (size_t)1 << (sizeof(size_t) * 8 - 1);
+
+		struct LongData
+		{
+			char* m_data;
+			size_t m_length;
+			size_t m_capacity;
+		};
+
+		union
+		{
+			LongData m_long;
+			char m_shortData[SSO_CAPACITY + 1];
+		};
+
+		bool isLong() const
+		{
+			return ((uint8_t)m_shortData[SSO_CAPACITY] & 0x80) != 0;
+		}
+
+		void setShort(size_t length)
+		{
+			//The terminating 0 is written separately, unless length == SSO_CAPACITY.
+			m_shortData[SSO_CAPACITY] = (char)(SSO_CAPACITY - length);
+		}
+
+		void setLong(char* data, size_t length, size_t capacity)
+		{
+			m_long.m_data = data;
+			m_long.m_length = length;
+			m_long.m_capacity = capacity | LONG_FLAG;
+		}
+
+		void setLength(size_t length)
+		{
+			if (isLong())
+			{
+				m_long.m_length = length;
+			}
+			else
+			{
+				setShort(length);
+			}
+		}
+
+		void setEmpty()
+		{
+			setShort(0);
+			m_shortData[0] = 0;
+		}
+
+		const char* skipWhitespace() const
+		{
+			const char* position = getRaw();
+			while (INTERNAL::utf8IsWhitespace(*position))
+			{
+				position++;
+			}
+			return position;
+		}
+
+		void initializeFromBytes(const char* data, size_t length)
+		{
+			if (length <= SSO_CAPACITY)
+			{
+				memcpy(m_shortData, data, length);
+				m_shortData[length] = 0;
+				setShort(length);
+			}
+			else
+			{
+				char* newData = new char[length + 1];
+				memcpy(newData, data, length);
+				newData[length] = 0;
+				setLong(newData, length, length + 1);
+			}
+		}
+
+		void initializeFromWide(const wchar_t* data, size_t length)
+		{
+			const wchar_t* end = data + length;
+			size_t utf8Length = 0;
+			for (const wchar_t* readHead = data; readHead != end;)
+			{
+				utf8Length += INTERNAL::utf8EncodedLength(INTERNAL::wideDecode(readHead, end));
+			}
+
+			setEmpty();
+			reserve(utf8Length);
+			char* writeHead = getRaw();
+			for (const wchar_t* readHead = data; readHead != end;)
+			{
+				writeHead += INTERNAL::utf8Encode(INTERNAL::wideDecode(readHead, end), writeHead);
+			}
+			*writeHead = 0;
+			setLength(utf8Length);
+		}
+
+		void freeData()
+		{
+			if (isLong())
+			{
+				delete[] m_long.m_data;
+			}
+		}
+
+		void append(const char* data, size_t length)
+		{
+			const size_t oldLength = getLength();
+			reserve(oldLength + length);
+			char* raw = getRaw();
+			memcpy(raw + oldLength, data, length);
+			raw[oldLength + length] = 0;
+			setLength(oldLength + length);
+		}
+
+		const char* find(const char* start, const char* needle, size_t needleLength) const
+		{
+			//The first byte is searched with memchr, candidates are then compared as a whole.
+			const char* end = getRaw() + getLength();
+			if (needleLength == 0 || (size_t)(end - start) < needleLength)
+			{
+				return nullptr;
+			}
+			const char* lastStart = end - needleLength;
+			const char first = needle[0];
+			while (start <= lastStart)
+			{
+				const char* candidate = static_cast<const char*>(memchr(start, first, lastStart - start + 1));
+				if (candidate == nullptr)
+				{
+					return nullptr;
+				}
+				if (memcmp(candidate + 1, needle + 1, needleLength - 1) == 0)
+				{
+					return candidate;
+				}
+				start = candidate + 1;
+			}
+			return nullptr;
+		}
+
+		void changeCase(bool toUpper)
+		{
+			char* raw = getRaw();
+			const size_t length = getLength();
+			size_t i = 0;
+			for (; i < length; i++)
+			{
+				const char c = raw[i];
+				if ((uint8_t)c >= 0x80)
+				{
+					break;
+				}
+				if (toUpper && c >= 'a' && c <= 'z')
+				{
+					raw[i] = c - 'a' + 'A';
+				}
+				else if (!toUpper && c >= 'A' && c <= 'Z')
+				{
+					raw[i] = c - 'A' + 'a';
+				}
+			}
+			if (i == length)
+			{
+				return;
+			}
+
+			//Changing the case of a non ASCII codepoint may change the length of its encoding.
+			Utf8String result;
+			result.reserve(length);
+			result.append(raw, i);
+			const char* readHead = raw + i;
+			const char* end = raw + length;
+			char encoded[4];
+			while (readHead != end)
+			{
+				const uint32_t codepoint = INTERNAL::utf8ChangeCase(INTERNAL::utf8Decode(readHead, end), toUpper);
+				result.append(encoded, INTERNAL::utf8Encode(codepoint, encoded));
+			}
+			*this = std::move(result);
+		}
+
+	public:
+		Utf8String()
+		{
+			setEmpty();
+		}
+
+		Utf8String(const char* data)
+		{
+			//data has to be UTF-8.
+			initializeFromBytes(data, strlen(data));
+		}
+
+		Utf8String(const char* data, size_t length)
+		{
+			initializeFromBytes(data, length);
+		}
+
+		Utf8String(const std::string& data)
+		{
+			initializeFromBytes(data.c_str(), data.length());
+		}
+
+		Utf8String(const wchar_t* data)
+		{
+			initializeFromWide(data, wcslen(data));
+		}
+
+		Utf8String(const std::wstring& data)
+		{
+			initializeFromWide(data.c_str(), data.length());
+		}
+
+		explicit Utf8String(const String& string)
+		{
+			initializeFromWide(string.getRaw(), string.getLength());
+		}
+
+		explicit Utf8String(int number)
+		{
+			char buffer[NUMBER_FORMAT_MAX_LENGTH];
+			initializeFromBytes(buffer, formatNumber((long long)number, buffer));
+		}
+
+		explicit Utf8String(long long number)
+		{
+			char buffer[NUMBER_FORMAT_MAX_LENGTH];
+			initializeFromBytes(buffer, formatNumber(number, buffer));
+		}
+
+		explicit Utf8String(unsigned long long number)
+		{
+			char buffer[NUMBER_FORMAT_MAX_LENGTH];
+			initializeFromBytes(buffer, formatNumber(number, buffer));
+		}
+
+		explicit Utf8String(double number)
+		{
+			char buffer[NUMBER_FORMAT_MAX_LENGTH];
+			initializeFromBytes(buffer, formatNumber(number, buffer));
+		}
+
+		Utf8String(const Utf8String& other)
+		{
+			initializeFromBytes(other.getRaw(), other.getLength());
+		}
+
+		Utf8String(Utf8String&& other)
+		{
+			memcpy(m_shortData, other.m_shortData, sizeof(m_shortData));
+			other.setEmpty();
+		}
+
+		Utf8String& operator=(const Utf8String& other)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+			freeData();
+			initializeFromBytes(other.getRaw(), other.getLength());
+			return *this;
+		}
+
+		Utf8String& operator=(Utf8String&& other)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+			freeData();
+			memcpy(m_shortData, other.m_shortData, sizeof(m_shortData));
+			other.setEmpty();
+			return *this;
+		}
+
+		~Utf8String()
+		{
+			freeData();
+		}
+
+		String toString() const
+		{
+			//Converts to wchar_t. The characters are written straight into the buffer the String adopts.
+			const char* end = getRaw() + getLength();
+			wchar_t units[2];
+			size_t wideLength = 0;
+			for (const char* readHead = getRaw(); readHead != end;)
+			{
+				wideLength += INTERNAL::wideEncode(INTERNAL::utf8Decode(readHead, end), units);
+			}
+			DynamicArray<wchar_t> wide(wideLength + 1, Uninitialized());
+			wchar_t* writeHead = wide.getRaw();
+			for (const char* readHead = getRaw(); readHead != end;)
+			{
+				writeHead += INTERNAL::wideEncode(INTERNAL::utf8Decode(readHead, end), writeHead);
+			}
+			*writeHead = 0;
+			return String(std::move(wide));
+		}
+
+		std::string toStdString() const
+		{
+			return std::string(getRaw(), getLength());
+		}
+
+		void reserve(size_t length)
+		{
+			//Makes room for length bytes plus the terminating 0.
+			const size_t capacity = getCapacity();
+			if (length < capacity)
+			{
+				return;
+			}
+			size_t newCapacity = length + 1;
+			if (newCapacity < capacity * 2)
+			{
+				newCapacity = capacity * 2;
+			}
+			const size_t oldLength = getLength();
+			char* newData = new char[newCapacity];
+			memcpy(newData, getRaw(), oldLength + 1);
+			freeData();
+			setLong(newData, oldLength, newCapacity);
+		}
+
+		bool operator==(const Utf8String& other) const
+		{
+			const size_t length = getLength();
+			return length == other.getLength() && memcmp(getRaw(), other.getRaw(), length) == 0;
+		}
+
+		bool operator==(const char* other) const
+		{
+			return strcmp(getRaw(), other) == 0;
+		}
+
+		bool operator!=(const Utf8String& other) const
+		{
+			return !operator==(other);
+		}
+
+		bool operator!=(const char* other) const
+		{
+			return !operator==(other);
+		}
+
+		friend bool operator==(const char* arr, const Utf8String& string)
+		{
+			return string.operator==(arr);
+		}
+
+		friend bool operator!=(const char* arr, const Utf8String& string)
+		{
+			return string.operator!=(arr);
+		}
+
+		friend std::ostream& operator<<(std::ostream& os, const Utf8String& string)
+		{
+			return os.write(string.getRaw(), string.getLength());
+		}
+
+		Utf8String operator+(const Utf8String& other) const
+		{
+			Utf8String retVal;
+			retVal.reserve(getLength() + other.getLength());
+			retVal.append(getRaw(), getLength());
+			retVal.append(other.getRaw(), other.getLength());
+			return retVal;
+		}
+
+		Utf8String operator+(const char* other) const
+		{
+			Utf8String retVal;
+			const size_t otherLength = strlen(other);
+			retVal.reserve(getLength() + otherLength);
+			retVal.append(getRaw(), getLength());
+			retVal.append(other, otherLength);
+			return retVal;
+		}
+
+		friend Utf8String operator+(const char* other, const Utf8String& string)
+		{
+			return Utf8String(other) + string;
+		}
+
+		Utf8String& operator+=(const Utf8String& other)
+		{
+			append(other.getRaw(), other.getLength());
+			return *this;
+		}
+
+		Utf8String& operator+=(const char* other)
+		{
+			append(other, strlen(other));
+			return *this;
+		}
+
+		Utf8String& operator+=(int number)
+		{
+			char buffer[NUMBER_FORMAT_MAX_LENGTH];
+			append(buffer, formatNumber((long long)number, buffer));
+			return *this;
+		}
+
+		Utf8String& operator+=(long long number)
+		{
+			char buffer[NUMBER_FORMAT_MAX_LENGTH];
+			append(buffer, formatNumber(number, buffer));
+			return *this;
+		}
+
+		Utf8String& operator+=(unsigned long long number)
+		{
+			char buffer[NUMBER_FORMAT_MAX_LENGTH];
+			append(buffer, formatNumber(number, buffer));
+			return *this;
+		}
+
+		Utf8String& operator+=(double number)
+		{
+			char buffer[NUMBER_FORMAT_MAX_LENGTH];
+			append(buffer, formatNumber(number, buffer));
+			return *this;
+		}
+
+		void appendCodepoint(uint32_t codepoint)
+		{
+			char encoded[4];
+			append(encoded, INTERNAL::utf8Encode(codepoint, encoded));
+		}
+
+		void trim()
+		{
+			//Removes ASCII whitespace from both ends.
+			char* raw = getRaw();
+			size_t start = 0;
+			size_t end = getLength();
+			while (start < end && INTERNAL::utf8IsWhitespace(raw[start]))
+			{
+				start++;
+			}
+			while (end > start && INTERNAL::utf8IsWhitespace(raw[end - 1]))
+			{
+				end--;
+			}
+			const size_t length = end - start;
+			if (start != 0)
+			{
+				memmove(raw, raw + start, length);
+			}
+			raw[length] = 0;
+			setLength(length);
+		}
+
+		size_t count(const char* countand, size_t countandLength) const
+		{
+			size_t amount = 0;
+			const char* readHead = getRaw();
+			while ((readHead = find(readHead, countand, countandLength)) != nullptr)
+			{
+				amount++;
+				readHead += countandLength;
+			}
+			return amount;
+		}
+
+		size_t count(const char* countand) const
+		{
+			return count(countand, strlen(countand));
+		}
+
+		size_t count(const Utf8String& countand) const
+		{
+			return count(countand.getRaw(), countand.getLength());
+		}
+
+		DynamicArray<Utf8String> split(const char* splitAt, size_t splitAtLength) const
+		{
+			//Searches the string only once. The pieces are collected in a List whose buffer is then
+			//adopted by the DynamicArray.
+			List<Utf8String> pieces;
+			const char* previousFinding = getRaw();
+			const char* currentFinding;
+			while ((currentFinding = find(previousFinding, splitAt, splitAtLength)) != nullptr)
+			{
+				pieces.pushBack(Utf8String(previousFinding, currentFinding - previousFinding));
+				previousFinding = currentFinding + splitAtLength;
+			}
+			pieces.pushBack(Utf8String(previousFinding, getRaw() + getLength() - previousFinding));
+			return DynamicArray<Utf8String>(pieces.release());
+		}
+
+		DynamicArray<Utf8String> split(const char* splitAt) const
+		{
+			return split(splitAt, strlen(splitAt));
+		}
+
+		DynamicArray<Utf8String> split(const Utf8String& splitAt) const
+		{
+			return split(splitAt.getRaw(), splitAt.getLength());
+		}
+
+		bool contains(const char* string, size_t length) const
+		{
+			return search(string, length) >= 0;
+		}
+
+		bool contains(const char* string) const
+		{
+			return contains(string, strlen(string));
+		}
+
+		bool contains(const Utf8String& string) const
+		{
+			return contains(string.getRaw(), string.getLength());
+		}
+
+		int64_t search(const char* string, size_t length) const
+		{
+			//Returns the byte offset of the first occurrence, or -1. The empty string is found at 0.
+			if (length == 0)
+			{
+				return 0;
+			}
+			const char* found = find(getRaw(), string, length);
+			if (found == nullptr)
+			{
+				return -1;
+			}
+			return found - getRaw();
+		}
+
+		int64_t search(const char* string) const
+		{
+			return search(string, strlen(string));
+		}
+
+		int64_t search(const Utf8String& string) const
+		{
+			return search(string.getRaw(), string.getLength());
+		}
+
+		long toLong(int base = 10) const
+		{
+			//Like strtol, but independent of the locale.
+			long long value = 0;
+			parseNumber(skipWhitespace(), getRaw() + getLength(), value, base);
+			if (value > LONG_MAX)
+			{
+				return LONG_MAX;
+			}
+			if (value < LONG_MIN)
+			{
+				return LONG_MIN;
+			}
+			return (long)value;
+		}
+
+		double toDouble() const
+		{
+			double value = 0;
+			parseNumber(skipWhitespace(), getRaw() + getLength(), value);
+			return value;
+		}
+
+		float toFloat() const
+		{
+			float value = 0;
+			parseNumber(skipWhitespace(), getRaw() + getLength(), value);
+			return value;
+		}
+
+		void toUpperCase()
+		{
+			changeCase(true);
+		}
+
+		void toLowerCase()
+		{
+			changeCase(false);
+		}
+
+		char& operator[](size_t index)
+		{
+			return getRaw()[index];
+		}
+
+		const char& operator[](size_t index) const
+		{
+			return getRaw()[index];
+		}
+
+		char* getRaw()
+		{
+			return isLong() ? m_long.m_data : m_shortData;
+		}
+
+		const char* getRaw() const
+		{
+			return isLong() ? m_long.m_data : m_shortData;
+		}
+
+		Utf8CodepointRange getCodepoints() const
+		{
+			return Utf8CodepointRange(getRaw(), getRaw() + getLength());
+		}
+
+		size_t getAmountOfCodepoints() const
+		{
+			//Every byte that is not a continuation byte starts a codepoint. Malformed text may contain
+			//more codepoints when it is iterated, as every stray byte becomes a U+FFFD.
+			const char* raw = getRaw();
+			const size_t length = getLength();
+			size_t amount = 0;
+			for (size_t i = 0; i < length; i++)
+			{
+				amount += ((uint8_t)raw[i] & 0xC0) != 0x80;
+			}
+			return amount;
+		}
+
+		size_t getLength() const
+		{
+			//In bytes.
+			if (isLong())
+			{
+				return m_long.m_length;
+			}
+			return SSO_CAPACITY - (size_t)(uint8_t)m_shortData[SSO_CAPACITY];
+		}
+
+		bool isEmpty() const
+		{
+			return getLength() == 0;
+		}
+
+		size_t getCapacity() const
+		{
+			//In bytes, including the terminating 0.
+			if (isLong())
+			{
+				return m_long.m_capacity & ~LONG_FLAG;
+			}
+			return SSO_CAPACITY + 1;
+		}
+	};
+}
\ No newline at end of file
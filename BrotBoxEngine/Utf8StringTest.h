@@ -0,0 +1,197 @@
+#pragma once
+
+#include <clocale>
+#include <cstring>
+#include <string>
+#include "Utf8String.h"
+#include "String.h"
+#include "UtilTest.h"
+
+namespace bbe
+{
+	namespace test
+	{
+		void testUtf8String()
+		{
+			{
+				Utf8String empty;
+				assertEquals(empty.getLength(), 0);
+				assertEquals(empty.isEmpty(), true);
+				assertEquals(empty, "");
+
+				Utf8String shortString("Hallo");
+				Utf8String longString("This text does not fit into the SSO storage");
+				assertEquals(shortString.getLength(), 5);
+				assertEquals(longString.getLength(), 43);
+				assertEquals(shortString, "Hallo");
+				assertEquals("Hallo", shortString);
+				assertUnequals(shortString, "Hallp");
+
+				Utf8String copy(longString);
+				assertEquals(copy, longString);
+				Utf8String moved(std::move(copy));
+				assertEquals(moved, longString);
+				assertEquals(copy.getLength(), 0);
+				copy = shortString;
+				assertEquals(copy, "Hallo");
+				copy = std::move(moved);
+				assertEquals(copy, longString);
+
+				Utf8String concat = shortString + " " + longString;
+				assertEquals(concat.getLength(), 49);
+				concat += "!";
+				concat += 42;
+				assertEquals(concat, "Hallo This text does not fit into the SSO storage!42");
+			}
+
+			{
+				//"\xC3\xA4" is U+00E4, "\xE2\x82\xAC" is U+20AC and "\xF0\x9F\x98\x80" is U+1F600.
+				Utf8String text("a\xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80");
+				assertEquals(text.getLength(), 10);
+				assertEquals(text.getAmountOfCodepoints(), 4);
+				uint32_t codepoints[4];
+				size_t i = 0;
+				for (uint32_t codepoint : text.getCodepoints())
+				{
+					codepoints[i++] = codepoint;
+				}
+				assertEquals(i, 4);
+				assertEquals(codepoints[0], 0x61);
+				assertEquals(codepoints[1], 0xE4);
+				assertEquals(codepoints[2], 0x20AC);
+				assertEquals(codepoints[3], 0x1F600);
+
+				String wide = text.toString();
+				assertEquals(wide.getLength(), sizeof(wchar_t) == 2 ? 5 : 4);
+				assertEquals(wide[1], (wchar_t)0xE4);
+				Utf8String back(wide);
+				assertEquals(back, text);
+				assertEquals(Utf8String(L"ä€"), "\xC3\xA4\xE2\x82\xAC");
+
+				Utf8String appended;
+				appended.appendCodepoint(0x61);
+				appended.appendCodepoint(0xE4);
+				appended.appendCodepoint(0x20AC);
+				appended.appendCodepoint(0x1F600);
+				assertEquals(appended, text);
+			}
+
+			{
+				//Malformed bytes become U+FFFD one at a time.
+				Utf8String malformed("a\xC3(\x80\xED\xA0\x80");
+				size_t amount = 0;
+				size_t replacements = 0;
+				for (uint32_t codepoint : malformed.getCodepoints())
+				{
+					amount++;
+					replacements += codepoint == 0xFFFD;
+				}
+				assertEquals(amount, 7);
+				assertEquals(replacements, 5);
+			}
+
+			{
+				Utf8String text("  \t eins,zwei,,dr\xC3\xA4i \n");
+				text.trim();
+				assertEquals(text, "eins,zwei,,dr\xC3\xA4i");
+				assertEquals(text.count(","), 3);
+				assertEquals(text.contains("zwei"), true);
+				assertEquals(text.contains("drei"), false);
+				assertEquals(text.search("zwei"), 5);
+				assertEquals(text.search("\xC3\xA4"), 13);
+				assertEquals(text.search("x"), -1);
+
+				DynamicArray<Utf8String> parts = text.split(",");
+				assertEquals(parts.getLength(), 4);
+				assertEquals(parts[0], "eins");
+				assertEquals(parts[1], "zwei");
+				assertEquals(parts[2], "");
+				assertEquals(parts[3], "dr\xC3\xA4i");
+
+				DynamicArray<Utf8String> unsplit = text.split(";");
+				assertEquals(unsplit.getLength(), 1);
+				assertEquals(unsplit[0], text);
+
+				Utf8String whitespace("   ");
+				whitespace.trim();
+				assertEquals(whitespace, "");
+				Utf8String empty;
+				empty.trim();
+				assertEquals(empty, "");
+			}
+
+			{
+				Utf8String ascii("Hello World 123");
+				ascii.toUpperCase();
+				assertEquals(ascii, "HELLO WORLD 123");
+				ascii.toLowerCase();
+				assertEquals(ascii, "hello world 123");
+
+				//Non ASCII codepoints are converted with towupper and towlower, which need a locale that knows
+				//them. U+00FC becomes U+00DC, U+00DF has no single uppercase codepoint and stays.
+				const std::string previousLocale = setlocale(LC_CTYPE, nullptr);
+				const bool hasUtf8 = setlocale(LC_CTYPE, "C.UTF-8") != nullptr || setlocale(LC_CTYPE, ".UTF8") != nullptr;
+				if (hasUtf8)
+				{
+					Utf8String umlauts("gr\xC3\xBC\xC3\x9F" "e");
+					umlauts.toUpperCase();
+					assertEquals(umlauts, "GR\xC3\x9C\xC3\x9F" "E");
+					assertEquals(umlauts.getAmountOfCodepoints(), 5);
+					umlauts.toLowerCase();
+					assertEquals(umlauts, "gr\xC3\xBC\xC3\x9F" "e");
+				}
+				setlocale(LC_CTYPE, previousLocale.c_str());
+
+				assertEquals(Utf8String("1234").toLong(), 1234);
+				assertEquals(Utf8String("ff").toLong(16), 255);
+				assertEquals(Utf8String("2.5").toDouble(), 2.5);
+			}
+
+			{
+				assertEquals(sizeof(Utf8String), 3 * sizeof(size_t));
+
+				//The last byte of the short storage doubles as the terminating 0 of a full short string.
+				Utf8String atLimit(Utf8String("abcdefghijklmnopqrstuvwxyz", Utf8String::SSO_CAPACITY));
+				Utf8String overLimit(Utf8String("abcdefghijklmnopqrstuvwxyz", Utf8String::SSO_CAPACITY + 1));
+				assertEquals(atLimit.getLength(), Utf8String::SSO_CAPACITY);
+				assertEquals(atLimit.getCapacity(), Utf8String::SSO_CAPACITY + 1);
+				assertEquals(atLimit.getRaw()[Utf8String::SSO_CAPACITY], 0);
+				assertEquals(overLimit.getLength(), Utf8String::SSO_CAPACITY + 1);
+				assertEquals(overLimit.getRaw()[Utf8String::SSO_CAPACITY + 1], 0);
+				atLimit += "z";
+				assertEquals(atLimit.getLength(), Utf8String::SSO_CAPACITY + 1);
+				assertEquals(atLimit.getRaw()[Utf8String::SSO_CAPACITY + 1], 0);
+				assertUnequals(atLimit, overLimit);
+				overLimit.trim();
+				atLimit = std::move(overLimit);
+				assertEquals(overLimit, "");
+				assertEquals(atLimit.getLength(), Utf8String::SSO_CAPACITY + 1);
+			}
+
+			{
+				//Needles that are longer than the short storage, given with and without their length.
+				const char* separator = " -- a separator longer than the short storage -- ";
+				Utf8String text = Utf8String("eins") + separator + "zwei" + separator + separator;
+				assertEquals(text.count(separator), 3);
+				assertEquals(text.count(Utf8String(separator)), 3);
+				assertEquals(text.count(separator, 4), 6);
+				assertEquals(text.contains(separator), true);
+				assertEquals(text.search(separator), 4);
+				assertEquals(text.search("zwei", 3), (int64_t)(4 + strlen(separator)));
+				assertEquals(text.contains("zwo", 3), false);
+
+				DynamicArray<Utf8String> parts = text.split(separator);
+				assertEquals(parts.getLength(), 4);
+				assertEquals(parts[0], "eins");
+				assertEquals(parts[1], "zwei");
+				assertEquals(parts[2], "");
+				assertEquals(parts[3], "");
+
+				//A length also allows 0 bytes in the needle.
+				Utf8String withZero("a\0b\0c", 5);
+				assertEquals(withZero.split("\0", 1).getLength(), 3);
+				assertEquals(withZero.search("b\0c", 3), 2);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include "UtilMath.h"
+
+namespace bbe
+{
+	inline uint64_t hashMix(uint64_t val)
+	{
+		//Finalizer of MurmurHash3. Spreads every input bit over the whole word,
+		//which is required because the HashMap uses both the high and the low bits.
+		val ^= val >> 33;
+		val *= 0xff51afd7ed558ccdULL;
+		val ^= val >> 33;
+		val *= 0xc4ceb9fe1a85ec53ULL;
+		val ^= val >> 33;
+		return val;
+	}
+
+	namespace INTERNAL
+	{
+		static constexpr uint64_t HASH_SECRET[4] = { 0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL };
+
+		inline uint64_t hashMultiplyFold(uint64_t a, uint64_t b)
+		{
+			uint64_t low;
+			uint64_t high;
+			multiply128(a, b, low, high);
+			return low ^ high;
+		}
+
+		inline uint64_t hashRead8(const uint8_t* data)
+		{
+			uint64_t val;
+			memcpy(&val, data, sizeof(val));
+			return val;
+		}
+
+		inline uint64_t hashRead4(const uint8_t* data)
+		{
+			uint32_t val;
+			memcpy(&val, data, sizeof(val));
+			return val;
+		}
+
+		inline uint64_t hashRead3(const uint8_t* data, size_t length)
+		{
+			//Reads 1 to 3 bytes, some of them twice.
+			return ((uint64_t)data[0] << 16) | ((uint64_t)data[length >> 1] << 8) | data[length - 1];
+		}
+	}
+
+	inline uint64_t hashBytes(const void* data, size_t length, uint64_t seed = 0)
+	{
+		//wyhash: 48 bytes per iteration in three independent lanes, every step is one 64x64->128 bit
+		//multiplication whose halves are folded together. Not suitable where attackers choose the keys.
+		using namespace INTERNAL;
+		const uint8_t* p = static_cast<const uint8_t*>(data);
+		seed ^= hashMultiplyFold(seed ^ HASH_SECRET[0], HASH_SECRET[1]);
+		uint64_t a;
+		uint64_t b;
+		if (length <= 16)
+		{
+			if (length >= 4)
+			{
+				a = (hashRead4(p) << 32) | hashRead4(p + ((length >> 3) << 2));
+				b = (hashRead4(p + length - 4) << 32) | hashRead4(p + length - 4 - ((length >> 3) << 2));
+			}
+			else if (length > 0)
+			{
+				a = hashRead3(p, length);
+				b = 0;
+			}
+			else
+			{
+				a = 0;
+				b = 0;
+			}
+		}
+		else
+		{
+			size_t left = length;
+			if (left > 48)
+			{
+				uint64_t seed1 = seed;
+				uint64_t seed2 = seed;
+				do
+				{
+					seed = hashMultiplyFold(hashRead8(p) ^ HASH_SECRET[1], hashRead8(p + 8) ^ seed);
+					seed1 = hashMultiplyFold(hashRead8(p + 16) ^ HASH_SECRET[2], hashRead8(p + 24) ^ seed1);
+					seed2 = hashMultiplyFold(hashRead8(p + 32) ^ HASH_SECRET[3], hashRead8(p + 40) ^ seed2);
+					p += 48;
+					left -= 48;
+				} while (left > 48);
+				seed ^= seed1 ^ seed2;
+			}
+			while (left > 16)
+			{
+				seed = hashMultiplyFold(hashRead8(p) ^ HASH_SECRET[1], hashRead8(p + 8) ^ seed);
+				p += 16;
+				left -= 16;
+			}
+			a = hashRead8(p + left - 16);
+			b = hashRead8(p + left - 8);
+		}
+		a ^= HASH_SECRET[1];
+		b ^= seed;
+		multiply128(a, b, a, b);
+		return hashMultiplyFold(a ^ HASH_SECRET[0] ^ length, b ^ HASH_SECRET[1]);
+	}
+
+	inline uint64_t hashCombine(uint64_t seed, uint64_t hash)
+	{
+		//Order dependent, so that sequences with the same elements in a different order differ.
+		return INTERNAL::hashMultiplyFold(seed ^ INTERNAL::HASH_SECRET[0], hash ^ INTERNAL::HASH_SECRET[1]);
+	}
+}
\ No newline at end of file
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <cstdint>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 
 namespace bbe
 {
@@ -19,4 +24,100 @@ namespace bbe
 
 		return val;
 	}
+
+	inline uint32_t countTrailingZeros(uint32_t val)
+	{
+		//val must not be 0
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward(&index, val);
+		return index;
+#else
+		return __builtin_ctz(val);
+#endif
+	}
+
+	inline uint32_t countTrailingZeros(uint64_t val)
+	{
+		//val must not be 0
+#if defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index;
+		_BitScanForward64(&index, val);
+		return index;
+#elif defined(_MSC_VER)
+		if ((uint32_t)val != 0)
+		{
+			return countTrailingZeros((uint32_t)val);
+		}
+		return 32 + countTrailingZeros((uint32_t)(val >> 32));
+#else
+		return __builtin_ctzll(val);
+#endif
+	}
+
+	inline uint32_t countLeadingZeros(uint64_t val)
+	{
+		//val must not be 0
+#if defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index;
+		_BitScanReverse64(&index, val);
+		return 63 - index;
+#elif defined(_MSC_VER)
+		unsigned long index;
+		if ((val >> 32) != 0)
+		{
+			_BitScanReverse(&index, (uint32_t)(val >> 32));
+			return 31 - index;
+		}
+		_BitScanReverse(&index, (uint32_t)val);
+		return 63 - index;
+#else
+		return __builtin_clzll(val);
+#endif
+	}
+
+	inline void multiply128(uint64_t a, uint64_t b, uint64_t& low, uint64_t& high)
+	{
+		//Full 128 bit product of a and b.
+#if defined(_MSC_VER) && defined(_M_X64)
+		low = _umul128(a, b, &high);
+#elif defined(__SIZEOF_INT128__)
+		const unsigned __int128 product = (unsigned __int128)a * b;
+		low = (uint64_t)product;
+		high = (uint64_t)(product >> 64);
+#else
+		const uint64_t lowMask = 0xFFFFFFFFULL;
+		const uint64_t aLow = a & lowMask;
+		const uint64_t aHigh = a >> 32;
+		const uint64_t bLow = b & lowMask;
+		const uint64_t bHigh = b >> 32;
+		const uint64_t lowLow = aLow * bLow;
+		const uint64_t lowHigh = aLow * bHigh;
+		const uint64_t highLow = aHigh * bLow;
+		const uint64_t highHigh = aHigh * bHigh;
+		const uint64_t middle = (lowLow >> 32) + (lowHigh & lowMask) + (highLow & lowMask);
+		low = (middle << 32) | (lowLow & lowMask);
+		high = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+#endif
+	}
+
+	inline uint32_t popCount(uint64_t val)
+	{
+#if defined(_MSC_VER) && defined(_M_X64) && defined(__AVX__)
+		//__popcnt64 needs the POPCNT instruction, which every CPU with AVX has.
+		return (uint32_t)__popcnt64(val);
+#elif defined(_MSC_VER)
+		val = val - ((val >> 1) & 0x5555555555555555ull);
+		val = (val & 0x3333333333333333ull) + ((val >> 2) & 0x3333333333333333ull);
+		val = (val + (val >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+		return (uint32_t)((val * 0x0101010101010101ull) >> 56);
+#else
+		return __builtin_popcountll(val);
+#endif
+	}
+
+	constexpr size_t nextPowerOfTwo(size_t val)
+	{
+		return val <= 1 ? 1 : nextPowerOfTwo((val + 1) / 2) * 2;
+	}
 }
\ No newline at end of file